@@ -0,0 +1,47 @@
+#pragma once
+
+#include "pseudo_pext.hpp"
+
+#include <lookup/eytzinger_lookup.hpp>
+#include <lookup/input.hpp>
+
+#include <cstddef>
+#include <cstdio>
+
+#include <nanobench.h>
+
+template <auto data, typename T> constexpr auto make_eytzinger() {
+    return lookup::eytzinger_lookup<>::make(
+        CX_VALUE(lookup::input<T, T, data.size()>{0, pp::input_data<data, T>}));
+}
+
+template <auto data, typename T>
+__attribute__((noinline, flatten)) T do_eytzinger(T k) {
+    constexpr static auto map = make_eytzinger<data, T>();
+    return map[k];
+}
+
+template <auto data, typename T> void bench_eytzinger(auto name) {
+    constexpr static auto map = make_eytzinger<data, T>();
+
+    printf("size:      %lu\n", sizeof(map));
+
+    T k = static_cast<T>(data[0].first);
+
+    do_eytzinger<data, T>(k);
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run("chained", [&] {
+        k = map[k];
+        ankerl::nanobench::doNotOptimizeAway(k);
+    });
+
+    auto i = std::size_t{};
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run(
+        "independent", [&] {
+            auto v = map[static_cast<T>(data[i].first)];
+            i++;
+            if (i >= data.size()) {
+                i = 0;
+            }
+            ankerl::nanobench::doNotOptimizeAway(v);
+        });
+}
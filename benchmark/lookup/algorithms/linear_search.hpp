@@ -0,0 +1,65 @@
+#pragma once
+
+#include "pseudo_pext.hpp"
+
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/simd_linear_search_lookup.hpp>
+
+#include <cstddef>
+#include <cstdio>
+
+#include <nanobench.h>
+
+constexpr auto linear_search_max_size = std::size_t{64};
+
+template <auto data, typename T, typename Strategy>
+constexpr auto make_linear_search() {
+    return Strategy::make(
+        CX_VALUE(lookup::input<T, T, data.size()>{0, pp::input_data<data, T>}));
+}
+
+template <auto data, typename T, typename Strategy>
+__attribute__((noinline, flatten)) T do_linear_search(T k) {
+    constexpr static auto map = make_linear_search<data, T, Strategy>();
+    return map[k];
+}
+
+template <auto data, typename T, typename Strategy>
+void bench_linear_search_strategy(auto name) {
+    constexpr static auto map = make_linear_search<data, T, Strategy>();
+
+    printf("size:      %lu\n", sizeof(map));
+
+    T k = static_cast<T>(data[0].first);
+
+    do_linear_search<data, T, Strategy>(k);
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run("chained", [&] {
+        k = map[k];
+        ankerl::nanobench::doNotOptimizeAway(k);
+    });
+
+    auto i = std::size_t{};
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run(
+        "independent", [&] {
+            auto v = map[static_cast<T>(data[i].first)];
+            i++;
+            if (i >= data.size()) {
+                i = 0;
+            }
+            ankerl::nanobench::doNotOptimizeAway(v);
+        });
+
+    pp::bench_batched<data, T>(map);
+}
+
+template <auto data, typename T> void bench_linear_search(auto name) {
+    bench_linear_search_strategy<
+        data, T, lookup::linear_search_lookup<linear_search_max_size>>(name);
+}
+
+template <auto data, typename T> void bench_simd_linear_search(auto name) {
+    bench_linear_search_strategy<
+        data, T, lookup::simd_linear_search_lookup<linear_search_max_size>>(
+        name);
+}
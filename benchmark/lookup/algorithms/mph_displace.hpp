@@ -0,0 +1,57 @@
+#pragma once
+
+#include "pseudo_pext.hpp"
+
+#include <lookup/input.hpp>
+#include <lookup/mph_displace_lookup.hpp>
+
+#include <cstddef>
+#include <cstdio>
+
+#include <nanobench.h>
+
+template <auto data, typename T, std::size_t avg_bucket_size = 4>
+constexpr auto make_mph_displace() {
+    return lookup::mph_displace_lookup<avg_bucket_size>::make(
+        CX_VALUE(lookup::input<T, T, data.size()>{0, pp::input_data<data, T>}));
+}
+
+template <auto data, typename T, std::size_t avg_bucket_size = 4>
+__attribute__((noinline, flatten)) T do_mph_displace(T k) {
+    constexpr static auto map = make_mph_displace<data, T, avg_bucket_size>();
+    return map[k];
+}
+
+template <auto data, typename T, std::size_t avg_bucket_size = 4>
+void bench_mph_displace(auto name) {
+    constexpr static auto map = make_mph_displace<data, T, avg_bucket_size>();
+
+    printf("size:      %lu\n", sizeof(map));
+
+    T k = static_cast<T>(data[0].first);
+
+    do_mph_displace<data, T, avg_bucket_size>(k);
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run("chained", [&] {
+        k = map[k];
+        ankerl::nanobench::doNotOptimizeAway(k);
+    });
+
+    auto i = std::size_t{};
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run(
+        "independent", [&] {
+            auto v = map[static_cast<T>(data[i].first)];
+            i++;
+            if (i >= data.size()) {
+                i = 0;
+            }
+            ankerl::nanobench::doNotOptimizeAway(v);
+        });
+}
+
+template <auto data, typename T> void bench_mph_displace_4(auto name) {
+    bench_mph_displace<data, T, 4>(name);
+}
+
+template <auto data, typename T> void bench_mph_displace_8(auto name) {
+    bench_mph_displace<data, T, 8>(name);
+}
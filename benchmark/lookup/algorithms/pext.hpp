@@ -0,0 +1,71 @@
+#pragma once
+
+#include "pseudo_pext.hpp"
+
+#include <lookup/input.hpp>
+#include <lookup/pext_lookup.hpp>
+
+#include <cstddef>
+#include <cstdio>
+
+#include <nanobench.h>
+
+template <auto data, typename T, bool indirect = true,
+          std::size_t max_search_len = 2>
+constexpr auto make_pext() {
+    return lookup::pext_lookup<indirect, max_search_len>::make(
+        CX_VALUE(lookup::input<T, T, data.size()>{0, pp::input_data<data, T>}));
+}
+
+template <auto data, typename T, bool indirect = true,
+          std::size_t max_search_len = 2>
+__attribute__((noinline, flatten)) T do_pext(T k) {
+    constexpr static auto map = make_pext<data, T, indirect, max_search_len>();
+    return map[k];
+}
+
+template <auto data, typename T, bool indirect = true,
+          std::size_t max_search_len = 2>
+void bench_pext(auto name) {
+    constexpr static auto map = make_pext<data, T, indirect, max_search_len>();
+
+    printf("size:      %lu\n", sizeof(map));
+    printf("hw pext:   %d\n", lookup::hardware_pext_available);
+
+    T k = static_cast<T>(data[0].first);
+
+    do_pext<data, T, indirect, max_search_len>(k);
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run("chained", [&] {
+        k = map[k];
+        ankerl::nanobench::doNotOptimizeAway(k);
+    });
+
+    auto i = std::size_t{};
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run(
+        "independent", [&] {
+            auto v = map[static_cast<T>(data[i].first)];
+            i++;
+            if (i >= data.size()) {
+                i = 0;
+            }
+            ankerl::nanobench::doNotOptimizeAway(v);
+        });
+
+    pp::bench_batched<data, T>(map);
+}
+
+template <auto data, typename T> void bench_pext_direct(auto name) {
+    bench_pext<data, T, false, 1>(name);
+}
+
+template <auto data, typename T> void bench_pext_indirect_1(auto name) {
+    bench_pext<data, T, true, 1>(name);
+}
+
+template <auto data, typename T> void bench_pext_indirect_2(auto name) {
+    bench_pext<data, T, true, 2>(name);
+}
+
+template <auto data, typename T> void bench_pext_indirect_3(auto name) {
+    bench_pext<data, T, true, 3>(name);
+}
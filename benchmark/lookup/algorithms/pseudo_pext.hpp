@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdio>
+#include <span>
 
 #include <nanobench.h>
 
@@ -20,6 +21,33 @@ constexpr auto input_data = []() {
 
     return d;
 }();
+
+template <auto data, typename T>
+constexpr auto input_keys = []() {
+    std::array<T, data.size()> k{};
+
+    for (auto i = std::size_t{}; i < k.size(); i++) {
+        k[i] = static_cast<T>(data[i].first);
+    }
+
+    return k;
+}();
+
+// the "independent" access pattern, looking up every key in one batch call
+template <auto data, typename T> void bench_batched(auto const &map) {
+    if constexpr (requires {
+                      map.lookup(std::span<T const>{}, std::span<T>{});
+                  }) {
+        auto values = std::array<T, data.size()>{};
+        ankerl::nanobench::Bench()
+            .minEpochIterations(2000000 / data.size() + 1)
+            .batch(data.size())
+            .run("batched", [&] {
+                map.lookup(input_keys<data, T>, values);
+                ankerl::nanobench::doNotOptimizeAway(values);
+            });
+    }
+}
 } // namespace pp
 
 template <auto data, typename T, bool indirect = true,
@@ -63,6 +91,8 @@ void bench_pseudo_pext(auto name) {
             }
             ankerl::nanobench::doNotOptimizeAway(v);
         });
+
+    pp::bench_batched<data, T>(map);
 }
 
 template <auto data, typename T> void bench_pseudo_pext_direct(auto name) {
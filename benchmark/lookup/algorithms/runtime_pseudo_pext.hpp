@@ -0,0 +1,87 @@
+#pragma once
+
+#include "pseudo_pext.hpp"
+
+#include <lookup/entry.hpp>
+#include <lookup/runtime_lookup.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <span>
+
+#include <nanobench.h>
+
+// The runtime lookups are built from a copy of the dataset, as they would be
+// from data loaded at startup, into static buffers. Build time is measured
+// as well as query time, for comparison with std_unordered_map.
+
+namespace pp {
+template <typename T> void bench_queries(auto const &map, auto const &data) {
+    T k = static_cast<T>(data[0].first);
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run("chained", [&] {
+        k = map[k];
+        ankerl::nanobench::doNotOptimizeAway(k);
+    });
+
+    auto i = std::size_t{};
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run(
+        "independent", [&] {
+            auto v = map[static_cast<T>(data[i].first)];
+            i++;
+            if (i >= data.size()) {
+                i = 0;
+            }
+            ankerl::nanobench::doNotOptimizeAway(v);
+        });
+}
+} // namespace pp
+
+template <auto data, typename T, bool indirect = true,
+          std::size_t max_search_len = 2>
+void bench_runtime_pseudo_pext(auto name) {
+    using lookup_t =
+        lookup::runtime_pseudo_pext_lookup<T, T, indirect, max_search_len>;
+    using buffers_t = lookup::runtime_pseudo_pext_buffers<lookup_t, data.size(),
+                                                          std::size_t{1} << 16>;
+
+    static auto loaded = pp::input_data<data, T>;
+    static auto buffers = buffers_t{};
+    auto const entries = std::span<lookup::entry<T, T> const>{loaded};
+
+    ankerl::nanobench::Bench().minEpochIterations(10).run("build", [&] {
+        ankerl::nanobench::doNotOptimizeAway(buffers.build(0, entries));
+    });
+
+    auto const map = buffers.build(0, entries);
+    if (not map) {
+        printf("build failed\n");
+        return;
+    }
+
+    printf("size:      %lu\n",
+           sizeof(*map) + map->storage.size_bytes() +
+               map->lookup_table.size_bytes());
+
+    pp::bench_queries<T>(*map, data);
+    pp::bench_batched<data, T>(*map);
+}
+
+template <auto data, typename T>
+void bench_runtime_pseudo_pext_direct(auto name) {
+    bench_runtime_pseudo_pext<data, T, false, 1>(name);
+}
+
+template <auto data, typename T>
+void bench_runtime_pseudo_pext_indirect_2(auto name) {
+    bench_runtime_pseudo_pext<data, T, true, 2>(name);
+}
+
+template <auto data, typename T> void bench_runtime_linear_search(auto name) {
+    static auto loaded = pp::input_data<data, T>;
+    auto const map = lookup::runtime_linear_search_lookup<T, T>{0, loaded};
+
+    printf("size:      %lu\n", sizeof(map) + sizeof(loaded));
+
+    pp::bench_queries<T>(map, data);
+    pp::bench_batched<data, T>(map);
+}
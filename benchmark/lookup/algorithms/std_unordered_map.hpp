@@ -19,6 +19,15 @@ template <auto data, typename T> void bench_std_unordered_map(auto name) {
         map[p.first] = p.second;
     }
 
+    // for comparison with the runtime lookups (see runtime_pseudo_pext.hpp)
+    ankerl::nanobench::Bench().minEpochIterations(10).run("build", [&] {
+        auto m = std::unordered_map<T, T>{};
+        for (auto p : data) {
+            m[p.first] = p.second;
+        }
+        ankerl::nanobench::doNotOptimizeAway(m);
+    });
+
     printf("size:      %lu\n", sizeof(map) + allocated_size);
 
     T k = static_cast<T>(data[0].first);
@@ -0,0 +1,39 @@
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/mph_displace_lookup.hpp>
+#include <lookup/pext_lookup.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <array>
+#include <cstddef>
+
+// Builds one lookup for DATASET with the strategy named by STRATEGY. Nothing
+// is run: the compile time of this translation unit (reported by the build)
+// is the cost of constructing the lookup at compile time.
+
+namespace {
+using T = decltype(DATASET[0].first);
+
+constexpr auto input_data = []() {
+    std::array<lookup::entry<T, T>, DATASET.size()> d{};
+
+    for (auto i = std::size_t{}; i < d.size(); i++) {
+        d[i] = {static_cast<T>(DATASET[i].first),
+                static_cast<T>(DATASET[i].second)};
+    }
+
+    return d;
+}();
+
+using pseudo_pext_direct = lookup::pseudo_pext_lookup<false, 1>;
+using pseudo_pext_indirect_2 = lookup::pseudo_pext_lookup<true, 2>;
+using pext_indirect_2 = lookup::pext_lookup<true, 2>;
+using mph_displace_4 = lookup::mph_displace_lookup<4>;
+
+constexpr auto map = STRATEGY::make(
+    CX_VALUE(lookup::input<T, T, DATASET.size()>{0, input_data}));
+} // namespace
+
+int main() { return static_cast<int>(sizeof(map) == 0); }
@@ -1,7 +1,14 @@
+#include "algorithms/eytzinger.hpp"
+#include "algorithms/linear_search.hpp"
+#include "algorithms/pext.hpp"
 #include "algorithms/pseudo_pext.hpp"
+#include "algorithms/runtime_pseudo_pext.hpp"
 
 #include "algorithms/frozen_map.hpp"
 #include "algorithms/frozen_unordered_map.hpp"
+#include "algorithms/mph.hpp"
+#include "algorithms/mph_displace.hpp"
+#include "algorithms/mph_pext.hpp"
 #include "algorithms/std_map.hpp"
 #include "algorithms/std_unordered_map.hpp"
 
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <msg/field.hpp>
+#include <msg/message.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace bench {
+using namespace msg;
+
+using big_f = field<"big", std::uint32_t>::located<at{0_dw, 31_msb, 0_lsb}>;
+using med_f = field<"med", std::uint32_t>::located<at{1_dw, 15_msb, 0_lsb}>;
+using small_a_f =
+    field<"small_a", std::uint32_t>::located<at{1_dw, 23_msb, 16_lsb}>;
+using small_b_f =
+    field<"small_b", std::uint32_t>::located<at{1_dw, 31_msb, 24_lsb}>;
+using flag_1_f = field<"flag_1", bool>::located<at{2_dw, 0_msb, 0_lsb}>;
+using flag_2_f = field<"flag_2", bool>::located<at{2_dw, 1_msb, 1_lsb}>;
+using flag_3_f = field<"flag_3", bool>::located<at{2_dw, 2_msb, 2_lsb}>;
+
+using msg_defn = message<"bench_msg", big_f, med_f, small_a_f, small_b_f,
+                         flag_1_f, flag_2_f, flag_3_f>;
+
+using msg_t = owning<msg_defn>;
+
+// {big, med, small_a} values matched by each benchmark callback, in
+// registration order. Benchmark messages use the same values.
+constexpr auto callback_data = std::array<std::array<std::uint32_t, 3>, 256>{{
+    {7408991, 1529, 4}, {25790222, 1603, 10}, {686755, 764, 7},
+    {41609698, 2178, 26}, {52281510, 249, 5}, {31889573, 2946, 14},
+    {3221205, 226, 5}, {25993058, 1721, 4}, {100432494, 4815, 8},
+    {60581460, 94, 8}, {49293955, 604, 1}, {31889573, 94, 10},
+    {89547232, 1028, 5}, {11651136, 411, 2}, {8872200, 1392, 26},
+    {52281510, 861, 10}, {7203140, 1721, 9}, {12158142, 1011, 9},
+    {61707443, 252, 0}, {29897602, 369, 26}, {37597100, 174, 2},
+    {48754189, 884, 14}, {57295152, 1011, 10}, {11501494, 1028, 10},
+    {1582483, 139, 1}, {25102716, 411, 3}, {18420386, 1721, 1},
+    {8872200, 3918, 0}, {37597100, 1153, 4}, {14399730, 3852, 5},
+    {3346740, 1721, 10}, {89547232, 764, 5}, {31972723, 3138, 2},
+    {11651136, 3852, 4}, {18420386, 2946, 8}, {61707443, 1011, 26},
+    {12158142, 1028, 2}, {13467223, 1028, 2}, {1895786, 5, 0},
+    {4251912, 3918, 5}, {31889573, 604, 1}, {25993058, 1153, 5},
+    {48754189, 1028, 10}, {1146788, 1603, 1}, {31889573, 428, 18},
+    {34849760, 345, 8}, {7052035, 988, 2}, {78542133, 428, 4},
+    {28690868, 4815, 26}, {4251912, 861, 3}, {127101820, 225, 4},
+    {6656070, 1071, 4}, {2410641, 2179, 2}, {2255862, 338, 8},
+    {3221205, 2604, 8}, {686755, 433, 2}, {2872476, 369, 0},
+    {16348301, 411, 10}, {45450308, 651, 0}, {13019260, 428, 1},
+    {31972723, 2178, 0}, {60581460, 5, 4}, {57295152, 226, 2},
+    {19954040, 1096, 3}, {5060444, 988, 10}, {57295152, 1314, 4},
+    {8624366, 1028, 5}, {14348655, 249, 18}, {56778125, 531, 0},
+    {35154099, 3588, 1}, {78542133, 369, 2}, {16925693, 252, 5},
+    {89547232, 2179, 14}, {11651136, 1579, 3}, {8624366, 676, 9},
+    {7203140, 243, 5}, {61707443, 764, 14}, {2255862, 338, 2},
+    {13019260, 3138, 3}, {4747399, 1153, 14}, {4308812, 1392, 14},
+    {18420386, 1392, 5}, {16348301, 433, 2}, {3752116, 1314, 5},
+    {57295152, 226, 4}, {3346740, 411, 26}, {31889573, 1603, 26},
+    {19954040, 988, 1}, {13393613, 651, 4}, {100432494, 94, 26},
+    {32984781, 94, 2}, {26301699, 1096, 10}, {11501494, 174, 2},
+    {36923972, 411, 18}, {29897602, 988, 10}, {37597100, 604, 7},
+    {156064102, 1071, 2}, {21054211, 3918, 10}, {62294716, 1721, 10},
+    {13220408, 2179, 0}, {21054211, 100, 4}, {1582483, 764, 26},
+    {13393613, 338, 1}, {11924917, 1579, 3}, {8624366, 411, 10},
+    {8872200, 139, 10}, {12158142, 4815, 10}, {48754189, 249, 10},
+    {17198460, 884, 26}, {30549348, 225, 0}, {8749337, 4677, 14},
+    {16925693, 4815, 2}, {89547232, 277, 1}, {686755, 3852, 4},
+    {686755, 411, 8}, {16828919, 433, 0}, {1146788, 2604, 7},
+    {62626451, 1153, 14}, {6683087, 676, 3}, {49293955, 1721, 0},
+    {1146788, 1529, 18}, {2410641, 861, 2}, {45450308, 503, 10},
+    {25102716, 2179, 5}, {14399730, 369, 10}, {16052435, 225, 2},
+    {29897602, 1721, 0}, {6656070, 225, 7}, {8749337, 1153, 7},
+    {11501494, 252, 26}, {11651136, 139, 8}, {60581460, 1603, 4},
+    {14348655, 604, 14}, {2555344, 338, 4}, {16828919, 748, 5},
+    {25790222, 243, 7}, {62294716, 861, 3}, {89547232, 4815, 26},
+    {25993058, 604, 18}, {29897602, 433, 3}, {156064102, 531, 10},
+    {37597100, 428, 0}, {127101820, 249, 5}, {7011312, 3138, 3},
+    {7011312, 100, 5}, {13393613, 226, 2}, {4747399, 604, 14},
+    {26301699, 139, 4}, {3752116, 988, 3}, {73625537, 225, 5},
+    {13019260, 861, 14}, {14399730, 651, 10}, {41609698, 764, 2},
+    {18420386, 433, 4}, {48754189, 1579, 2}, {18420386, 2946, 1},
+    {31889573, 1028, 4}, {17198460, 764, 9}, {6375193, 174, 3},
+    {17118917, 2946, 4}, {48754189, 2178, 2}, {6656070, 604, 2},
+    {57295152, 4815, 2}, {52281510, 1028, 2}, {3752116, 3588, 10},
+    {773601, 94, 14}, {16828919, 1314, 3}, {25224297, 277, 5},
+    {1929157, 100, 0}, {7203140, 1721, 18}, {7052035, 428, 0},
+    {18420386, 226, 7}, {4308812, 369, 10}, {11488991, 1392, 8},
+    {773601, 225, 5}, {36923972, 249, 5}, {2255862, 411, 1},
+    {127101820, 503, 3}, {25993058, 861, 4}, {36923972, 1529, 4},
+    {60581460, 174, 5}, {35808318, 988, 18}, {20878407, 531, 9},
+    {6683087, 226, 26}, {2255862, 3588, 4}, {16828919, 1011, 10},
+    {29557916, 676, 4}, {1582483, 988, 2}, {2255862, 338, 0},
+    {7052035, 1028, 2}, {52281510, 5, 0}, {1710651, 100, 0}, {3752116, 4815, 4},
+    {78542133, 2604, 10}, {13467223, 3852, 1}, {3221205, 411, 10},
+    {31972723, 3588, 3}, {89547232, 748, 26}, {6656070, 3852, 2},
+    {14399730, 884, 5}, {25102716, 345, 0}, {11924917, 1529, 2},
+    {57295152, 2178, 18}, {35154099, 433, 2}, {21054211, 5, 14},
+    {29873573, 2179, 3}, {773601, 1603, 10}, {25790222, 5, 2},
+    {6656070, 100, 10}, {7408991, 1011, 8}, {5060444, 604, 3},
+    {2255862, 2179, 10}, {25224297, 338, 3}, {13467223, 338, 8},
+    {3752116, 651, 2}, {19954040, 604, 8}, {156064102, 369, 2},
+    {1929157, 1579, 10}, {18420386, 861, 2}, {29557916, 252, 9},
+    {25790222, 4677, 8}, {8749337, 1392, 3}, {7203140, 20, 10},
+    {7408991, 988, 18}, {16348301, 2530, 10}, {13019260, 1096, 10},
+    {25102716, 3852, 4}, {25993058, 345, 14}, {1710651, 861, 8},
+    {52281510, 3138, 10}, {45450308, 1096, 4}, {8624366, 676, 0},
+    {2872476, 1392, 26}, {11488991, 1603, 10}, {13220408, 1096, 5},
+    {31252036, 884, 14}, {8624366, 226, 2}, {842387, 1153, 18},
+    {6375193, 1314, 0}, {13019260, 2604, 14}, {13220408, 1071, 4},
+    {56228327, 243, 4}, {53124307, 2604, 5}, {21054211, 861, 1},
+    {20878407, 1028, 5}, {24553653, 604, 3}, {73625537, 531, 2},
+    {7408991, 3918, 2}, {3832590, 604, 1}, {14399730, 433, 8},
+    {25993058, 4677, 4}, {13393613, 249, 10}, {48754189, 604, 4},
+    {11685653, 2946, 4}, {8872200, 2946, 5}, {3832590, 2946, 18}
+}};
+
+inline auto make_msgs() {
+    std::array<msg_t, callback_data.size()> msgs{};
+    for (auto i = std::size_t{}; i < msgs.size(); i++) {
+        auto const [b, m, s] = callback_data[i];
+        msgs[i] = msg_t{"big"_field = b, "med"_field = m, "small_a"_field = s};
+    }
+    return msgs;
+}
+} // namespace bench
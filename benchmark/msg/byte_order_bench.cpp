@@ -0,0 +1,79 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+
+#include "bench_data.hpp"
+
+#include <msg/field.hpp>
+#include <msg/message.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <nanobench.h>
+
+// Decodes the big, med, small_a and small_b fields of 1M big-endian bench
+// messages: by byte-swapping each whole message into host order first, and by
+// swapping only the dwords that each field load touches.
+
+using namespace bench;
+
+namespace {
+using buffer_t = msg_defn::default_storage_t;
+
+using be_big_f = big_f::big_endian_t;
+using be_med_f = med_f::big_endian_t;
+using be_small_a_f = small_a_f::big_endian_t;
+using be_small_b_f = small_b_f::big_endian_t;
+
+constexpr auto num_msgs = std::size_t{1'000'000};
+
+struct fields {
+    std::uint32_t big{};
+    std::uint32_t med{};
+    std::uint32_t small_a{};
+    std::uint32_t small_b{};
+};
+
+auto make_buffers() {
+    auto rng = ankerl::nanobench::Rng{};
+    auto msgs = std::vector<buffer_t>(num_msgs);
+    for (auto &m : msgs) {
+        for (auto &dw : m) {
+            dw = static_cast<std::uint32_t>(rng());
+        }
+    }
+    return msgs;
+}
+} // namespace
+
+int main() {
+    auto const msgs = make_buffers();
+    auto const in = std::span<buffer_t const>{msgs};
+    auto out = std::vector<fields>(num_msgs);
+
+    ankerl::nanobench::Bench().batch(num_msgs).unit("msg").run(
+        "swap then decode", [&] {
+            for (auto i = std::size_t{}; i < num_msgs; ++i) {
+                auto host = buffer_t{};
+                std::transform(std::begin(in[i]), std::end(in[i]),
+                               std::begin(host), [](std::uint32_t dw) {
+                                   return msg::detail::byteswap(dw);
+                               });
+                out[i] = {big_f::extract(host), med_f::extract(host),
+                          small_a_f::extract(host), small_b_f::extract(host)};
+            }
+            ankerl::nanobench::doNotOptimizeAway(out);
+        });
+
+    ankerl::nanobench::Bench().batch(num_msgs).unit("msg").run(
+        "decode big-endian in place", [&] {
+            for (auto i = std::size_t{}; i < num_msgs; ++i) {
+                out[i] = {be_big_f::extract(in[i]), be_med_f::extract(in[i]),
+                          be_small_a_f::extract(in[i]),
+                          be_small_b_f::extract(in[i])};
+            }
+            ankerl::nanobench::doNotOptimizeAway(out);
+        });
+}
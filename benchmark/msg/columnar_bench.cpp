@@ -0,0 +1,85 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+
+#include "bench_data.hpp"
+
+#include <msg/columnar.hpp>
+#include <msg/field.hpp>
+#include <msg/message.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <nanobench.h>
+
+// Decodes the big, med, small_a and small_b fields of 1M bench messages, one
+// message at a time and a column at a time.
+
+using namespace bench;
+
+namespace {
+using buffer_t = msg_defn::default_storage_t;
+
+constexpr auto num_msgs = std::size_t{1'000'000};
+
+struct columns {
+    std::vector<std::uint32_t> big = std::vector<std::uint32_t>(num_msgs);
+    std::vector<std::uint32_t> med = std::vector<std::uint32_t>(num_msgs);
+    std::vector<std::uint32_t> small_a = std::vector<std::uint32_t>(num_msgs);
+    std::vector<std::uint32_t> small_b = std::vector<std::uint32_t>(num_msgs);
+};
+
+auto make_buffers() {
+    auto rng = ankerl::nanobench::Rng{};
+    auto msgs = std::vector<buffer_t>(num_msgs);
+    for (auto &m : msgs) {
+        for (auto &dw : m) {
+            dw = static_cast<std::uint32_t>(rng());
+        }
+    }
+    return msgs;
+}
+} // namespace
+
+int main() {
+    auto msgs = make_buffers();
+    auto const in = std::span<buffer_t const>{msgs};
+    auto out = columns{};
+
+    ankerl::nanobench::Bench().batch(num_msgs).unit("msg").run(
+        "decode (field by field)", [&] {
+            for (auto i = std::size_t{}; i < num_msgs; ++i) {
+                out.big[i] = big_f::extract(in[i]);
+                out.med[i] = med_f::extract(in[i]);
+                out.small_a[i] = small_a_f::extract(in[i]);
+                out.small_b[i] = small_b_f::extract(in[i]);
+            }
+            ankerl::nanobench::doNotOptimizeAway(out);
+        });
+
+    ankerl::nanobench::Bench().batch(num_msgs).unit("msg").run(
+        "decode (columnar)", [&] {
+            msg::extract_column<big_f>(in, std::span{out.big});
+            msg::extract_column<med_f>(in, std::span{out.med});
+            msg::extract_column<small_a_f>(in, std::span{out.small_a});
+            msg::extract_column<small_b_f>(in, std::span{out.small_b});
+            ankerl::nanobench::doNotOptimizeAway(out);
+        });
+
+    auto const values = std::span<std::uint32_t const>{out.small_a};
+    auto const buffers = std::span<buffer_t>{msgs};
+    ankerl::nanobench::Bench().batch(num_msgs).unit("msg").run(
+        "encode small_a (field by field)", [&] {
+            for (auto i = std::size_t{}; i < num_msgs; ++i) {
+                small_a_f::insert(buffers[i], values[i]);
+            }
+            ankerl::nanobench::doNotOptimizeAway(msgs);
+        });
+
+    ankerl::nanobench::Bench().batch(num_msgs).unit("msg").run(
+        "encode small_a (columnar)", [&] {
+            msg::insert_column<small_a_f>(buffers, values);
+            ankerl::nanobench::doNotOptimizeAway(msgs);
+        });
+}
@@ -0,0 +1,101 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+
+#include "bench_data.hpp"
+
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/pooled_values.hpp>
+
+#include <stdx/bitset.hpp>
+#include <stdx/compiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include <nanobench.h>
+
+// Builds the same per-field indices as the indexed handler does for the
+// handler_bench callbacks (one entry per distinct field value, mapping to the
+// bitset of callbacks that match it) and compares plain value storage with
+// pooled values, both in size and in lookup latency.
+
+namespace {
+using callback_bits_t =
+    stdx::bitset<bench::callback_data.size(), std::uint32_t>;
+
+template <std::size_t F> constexpr auto num_keys() {
+    auto keys = std::array<std::uint32_t, bench::callback_data.size()>{};
+    std::transform(std::cbegin(bench::callback_data),
+                   std::cend(bench::callback_data), std::begin(keys),
+                   [](auto const &d) { return d[F]; });
+    std::sort(std::begin(keys), std::end(keys));
+    return static_cast<std::size_t>(
+        std::distance(std::begin(keys), std::unique(std::begin(keys),
+                                                    std::end(keys))));
+}
+
+template <std::size_t F> struct index_input {
+    using cx_value_t [[maybe_unused]] = void;
+
+    CONSTEVAL auto operator()() const noexcept {
+        using entry_t = lookup::entry<std::uint32_t, callback_bits_t>;
+        auto entries = std::array<entry_t, num_keys<F>()>{};
+        auto n = std::size_t{};
+        for (auto cb = std::size_t{}; cb < bench::callback_data.size(); ++cb) {
+            auto const key = bench::callback_data[cb][F];
+            auto const it = std::find_if(
+                std::begin(entries), std::next(std::begin(entries), n),
+                [&](auto const &e) { return e.key_ == key; });
+            if (it == std::next(std::begin(entries), n)) {
+                entries[n++] = {key, callback_bits_t{}};
+            }
+        }
+        for (auto &e : entries) {
+            for (auto cb = std::size_t{}; cb < bench::callback_data.size();
+                 ++cb) {
+                if (bench::callback_data[cb][F] == e.key_) {
+                    e.value_.set(cb);
+                }
+            }
+        }
+        return lookup::input{callback_bits_t{}, entries};
+    }
+};
+
+template <typename Strategy, std::size_t F>
+void bench_index(std::string_view name) {
+    constexpr static auto index = Strategy::make(index_input<F>{});
+
+    std::printf("%-16s sizeof = %zu\n", std::string{name}.c_str(),
+                sizeof(index));
+
+    auto i = std::size_t{};
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run(
+        std::string{name}, [&] {
+            auto const key = bench::callback_data[i][F];
+            ankerl::nanobench::doNotOptimizeAway(index[key]);
+            i = (i + 1) % bench::callback_data.size();
+        });
+}
+
+template <std::size_t F> void bench_field(std::string_view field) {
+    using plain_t = lookup::default_strategies;
+    using pooled_t = lookup::pooled_values<lookup::default_strategies>;
+
+    bench_index<plain_t, F>(std::string{field} + " plain");
+    bench_index<pooled_t, F>(std::string{field} + " pooled");
+}
+} // namespace
+
+int main() {
+    bench_field<0>("big");
+    bench_field<1>("med");
+    bench_field<2>("small_a");
+}
@@ -0,0 +1,93 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+
+#include "bench_data.hpp"
+
+#include <cib/cib.hpp>
+#include <log/fmt/logger.hpp>
+#include <msg/callback.hpp>
+#include <msg/detail/log_unhandled.hpp>
+#include <msg/field.hpp>
+#include <msg/indexed_service.hpp>
+#include <msg/message.hpp>
+#include <msg/service.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include <nanobench.h>
+
+// Built twice: unhandled_bench describes each callback's mismatch when a
+// message is unhandled, and unhandled_bench_quiet (with
+// BENCH_QUIET_MISMATCHES) does not. Compare the two binaries with size(1)
+// for the code size of the diagnostic paths, and the latencies below for
+// their effect on the dispatch paths.
+
+using namespace bench;
+
+namespace {
+std::string log_buffer{};
+} // namespace
+
+template <>
+inline auto logging::config<> =
+    logging::fmt::config{std::back_inserter(log_buffer)};
+
+#ifdef BENCH_QUIET_MISMATCHES
+template <> constexpr inline auto msg::describe_mismatches<> = false;
+#endif
+
+namespace {
+struct test_service : service<msg_t> {};
+struct test_indexed_service
+    : indexed_service<index_spec<big_f, med_f, small_a_f>, msg_t> {};
+
+constexpr auto num_callbacks = std::size_t{32};
+
+uint64_t cb_count{};
+uint64_t volatile *cb_count_ptr = &cb_count;
+
+template <uint32_t B, uint32_t M, uint32_t S>
+constexpr auto cb = msg::callback<"callback", msg_defn>(
+    "big"_f.in<B> and "med"_f.in<M> and "small_a"_f.in<S>,
+    [](auto) { (*cb_count_ptr) = 0; });
+
+template <typename T> struct test_project {
+    constexpr static auto config =
+        []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return cib::config(
+                cib::exports<T>,
+                cib::extend<T>(cb<callback_data[Is][0], callback_data[Is][1],
+                                  callback_data[Is][2]>...));
+        }(std::make_index_sequence<num_callbacks>{});
+};
+
+template <typename T> void bench_unhandled(char const *name) {
+    cib::nexus<test_project<T>> test_nexus{};
+    test_nexus.init();
+
+    auto const msgs = make_msgs();
+    auto i = std::size_t{};
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run(
+        std::string{name} + " (handled)", [&] {
+            cib::service<T>->handle(msgs[i]);
+            i = (i + 1) % num_callbacks;
+        });
+
+    // the messages after the first num_callbacks match no callback
+    ankerl::nanobench::Bench().minEpochIterations(200000).run(
+        std::string{name} + " (unhandled)", [&] {
+            cib::service<T>->handle(msgs[num_callbacks + i]);
+            i = (i + 1) % num_callbacks;
+            log_buffer.clear();
+        });
+}
+} // namespace
+
+int main() {
+    bench_unhandled<test_service>("msgs");
+    bench_unhandled<test_indexed_service>("indexed msgs");
+}
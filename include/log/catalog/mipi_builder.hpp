@@ -2,6 +2,7 @@
 
 #include <log/catalog/catalog.hpp>
 #include <log/catalog/mipi_messages.hpp>
+#include <msg/variable_message.hpp>
 
 #include <stdx/compiler.hpp>
 #include <stdx/type_traits.hpp>
@@ -129,19 +130,20 @@ template <> struct builder<defn::compact64_build_msg_t> {
 template <> struct builder<defn::normal_build_msg_t> {
     template <auto Version, stdx::ct_string S> static auto build() {
         using namespace msg;
-        constexpr auto header_size =
-            defn::normal_build_msg_t::size<std::uint8_t>::value;
-        constexpr auto payload_len = S.size() + sizeof(std::uint64_t);
-        using storage_t = std::array<std::uint8_t, header_size + payload_len>;
+        using layout_t =
+            variable_message<defn::normal_build_msg_t,
+                             array_field<"version", std::uint64_t, 1>,
+                             array_field<"build_string", char, S.size()>>;
+        constexpr auto payload_len =
+            layout_t::fixed_size - layout_t::header_size;
+        using storage_t = std::array<std::uint8_t, layout_t::fixed_size>;
 
         defn::normal_build_msg_t::owner_t<storage_t> message{
             "payload_len"_field = payload_len};
-        auto dest = &message.data()[header_size];
-
-        auto const ver = stdx::to_le(static_cast<std::uint64_t>(Version));
-        std::memcpy(dest, &ver, sizeof(std::uint64_t));
-        dest += sizeof(std::uint64_t);
-        std::copy_n(std::cbegin(S.value), S.size(), dest);
+        auto const payload = layout_t::view(message.data());
+        payload.get("version"_field)
+            .set(0, static_cast<std::uint64_t>(Version));
+        payload.get("build_string"_field).assign(S.value);
         return message;
     }
 };
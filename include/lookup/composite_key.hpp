@@ -0,0 +1,80 @@
+#pragma once
+
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+namespace lookup {
+namespace detail {
+template <std::size_t Bytes> auto uint_of_size_f() {
+    static_assert(Bytes <= max_raw_key_size,
+                  "Composite key parts are too wide to pack into one key.");
+
+    if constexpr (Bytes <= 1) {
+        return std::uint8_t{};
+    } else if constexpr (Bytes <= 2) {
+        return std::uint16_t{};
+    } else if constexpr (Bytes <= 4) {
+        return std::uint32_t{};
+    } else if constexpr (Bytes <= 8) {
+        return std::uint64_t{};
+#if defined(__SIZEOF_INT128__)
+    } else {
+        return uint128_t{};
+#endif
+    }
+}
+
+template <std::size_t Bytes>
+using uint_of_size_t = decltype(uint_of_size_f<Bytes>());
+} // namespace detail
+
+// A key made of several integral or enum parts, e.g. the values of several
+// message fields. The parts are packed into one unsigned integer (first part
+// in the least significant bits) so that a lookup hashes across all of them
+// at once. Up to 16 bytes of parts are supported where the compiler provides
+// a 128-bit integer.
+template <typename... Ts> struct composite_key {
+    using raw_type =
+        detail::uint_of_size_t<(sizeof(detail::raw_integral_t<Ts>) + ...)>;
+
+    constexpr static auto offsets = [] {
+        auto offs = std::array<std::size_t, sizeof...(Ts)>{};
+        auto bits = std::size_t{};
+        auto i = std::size_t{};
+        ((offs[i++] = bits, bits += sizeof(detail::raw_integral_t<Ts>) * 8u),
+         ...);
+        return offs;
+    }();
+
+    raw_type raw{};
+
+    constexpr composite_key() = default;
+    constexpr explicit composite_key(Ts... parts) {
+        auto i = std::size_t{};
+        ((raw |= static_cast<raw_type>(
+              static_cast<raw_type>(detail::as_raw_integral(parts))
+              << offsets[i++])),
+         ...);
+    }
+
+    template <std::size_t I> [[nodiscard]] constexpr auto get() const {
+        using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+        using raw_t = detail::raw_integral_t<T>;
+        return std::bit_cast<T>(static_cast<raw_t>(raw >> offsets[I]));
+    }
+
+    // ordered by the raw representation, i.e. by the last part first
+    friend constexpr auto operator==(composite_key const &,
+                                     composite_key const &) -> bool = default;
+    friend constexpr auto operator<=>(composite_key const &,
+                                      composite_key const &) = default;
+};
+
+template <typename... Ts> composite_key(Ts...) -> composite_key<Ts...>;
+} // namespace lookup
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdx/compiler.hpp>
+
+#include <cstddef>
+#include <utility>
+
+namespace lookup {
+// The properties of a built lookup that a selection policy can trade off:
+// the bytes it occupies, and the number of dependent table accesses a lookup
+// makes in the worst case.
+struct cost_t {
+    std::size_t storage_bytes{};
+    std::size_t max_probes{};
+};
+
+template <typename T>
+constexpr auto max_probes_v = []() -> std::size_t {
+    if constexpr (requires { T::max_probes; }) {
+        return static_cast<std::size_t>(T::max_probes);
+    } else {
+        return 1;
+    }
+}();
+
+template <typename T>
+[[nodiscard]] CONSTEVAL auto cost_of(T const &) -> cost_t {
+    return {sizeof(T), max_probes_v<T>};
+}
+
+namespace optimize_for {
+// take the first strategy that succeeds, in the order given
+struct first_fit {};
+
+// smallest storage, then fewest probes
+struct size {
+    [[nodiscard]] constexpr static auto cost(cost_t c) {
+        return std::pair{c.storage_bytes, c.max_probes};
+    }
+};
+
+// fewest probes, then smallest storage
+struct latency {
+    [[nodiscard]] constexpr static auto cost(cost_t c) {
+        return std::pair{c.max_probes, c.storage_bytes};
+    }
+};
+
+// each probe is worth BytesPerProbe bytes of storage
+template <std::size_t BytesPerProbe> struct weighted {
+    [[nodiscard]] constexpr static auto cost(cost_t c) -> std::size_t {
+        return c.storage_bytes + BytesPerProbe * c.max_probes;
+    }
+};
+} // namespace optimize_for
+
+template <typename T>
+concept selection_policy = requires(cost_t c) {
+    { T::cost(c) < T::cost(c) };
+};
+} // namespace lookup
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+namespace lookup::detail {
+// keys looked up together in one stage of a batch: enough independent probes
+// in flight to cover a cache miss without spilling the per-key state
+constexpr auto batch_width = std::size_t{8};
+
+/// call f with successive blocks of at most batch_width keys and the
+/// corresponding values
+template <typename K, typename V, typename F>
+constexpr auto for_each_batch(std::span<K const> keys, std::span<V> values,
+                              F &&f) -> void {
+    for (auto i = std::size_t{}; i < keys.size(); i += batch_width) {
+        auto const n = std::min(batch_width, keys.size() - i);
+        f(keys.subspan(i, n), values.subspan(i, n));
+    }
+}
+} // namespace lookup::detail
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <lookup/detail/select.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <stdx/compiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace lookup {
+namespace detail {
+template <typename K> constexpr auto max_key() -> K {
+    if constexpr (std::is_enum_v<K>) {
+        return static_cast<K>(
+            std::numeric_limits<std::underlying_type_t<K>>::max());
+    } else if constexpr (std::is_arithmetic_v<K>) {
+        return std::numeric_limits<K>::max();
+    } else {
+        // e.g. composite_key, which orders by its raw representation
+        return std::bit_cast<K>(std::numeric_limits<raw_integral_t<K>>::max());
+    }
+}
+
+/// number of levels in the smallest complete tree holding n nodes
+constexpr auto eytzinger_depth(std::size_t n) -> std::size_t {
+    return static_cast<std::size_t>(std::bit_width(n));
+}
+
+/// place sorted[i...] into the (1-indexed) BFS layout in-order (n)
+template <typename Src, typename Dst>
+constexpr auto eytzinger_fill(Src const &sorted, Dst &dst, std::size_t &i,
+                              std::size_t k) -> void {
+    if (k < std::size(dst)) {
+        eytzinger_fill(sorted, dst, i, 2 * k);
+        dst[k] = sorted[i++];
+        eytzinger_fill(sorted, dst, i, 2 * k + 1);
+    }
+}
+} // namespace detail
+
+// Keys are sorted and laid out in BFS (Eytzinger) order, padded to a complete
+// tree, so the search is a fixed number of branchless steps whose memory
+// accesses are predictable enough to prefetch.
+//
+// With Ranged = false, lookup is an exact match. With Ranged = true, each key
+// is the inclusive lower bound of a range that extends up to the next key:
+// lookup returns the value of the greatest key not greater than the one
+// requested, or the default value if there is none.
+template <bool Ranged = false> struct eytzinger_lookup {
+  private:
+    template <typename Key, typename Value, typename Default, typename Keys,
+              typename Values>
+    struct impl {
+        using key_type = Key;
+        using value_type = Value;
+
+        constexpr static Value default_value = Default::value;
+        constexpr static auto depth =
+            detail::eytzinger_depth(std::tuple_size_v<Keys> - 1);
+        constexpr static auto max_probes = depth + 1;
+
+        // one cache line worth of keys is 2^prefetch_levels nodes
+        constexpr static auto prefetch_levels = static_cast<std::size_t>(
+            std::bit_width(64u / sizeof(key_type)) - 1);
+
+        Keys keys;
+        Values values;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            auto best = std::size_t{};
+            auto k = std::size_t{1};
+
+            for (auto level = std::size_t{}; level < depth; level++) {
+                if constexpr (depth > prefetch_levels) {
+                    if (not std::is_constant_evaluated()) {
+                        auto const ahead = std::min(k << prefetch_levels,
+                                                    std::size(keys) - 1);
+                        __builtin_prefetch(&keys[ahead]);
+                    }
+                }
+
+                auto const node = keys[k];
+                best = detail::select_lt(key, node, best, k);
+                k = 2 * k + detail::select_lt(key, node, std::size_t{},
+                                              std::size_t{1});
+            }
+
+            if constexpr (Ranged) {
+                return values[best];
+            } else {
+                return detail::select(key, keys[best], values[best],
+                                      default_value);
+            }
+        }
+    };
+
+    template <typename lambda> struct default_value_smuggler {
+        constexpr static auto value = lambda{}().default_value;
+    };
+
+  public:
+    [[nodiscard]] CONSTEVAL static auto make(compile_time auto i) {
+        constexpr auto input = i();
+        using key_type = typename decltype(input)::key_type;
+        using value_type = typename decltype(input)::value_type;
+        using default_value = default_value_smuggler<decltype(i)>;
+
+        constexpr auto sorted = [&]() {
+            auto s = input.entries;
+            std::sort(std::begin(s), std::end(s),
+                      [](auto l, auto r) { return l.key_ < r.key_; });
+            return s;
+        }();
+
+        static_assert(std::adjacent_find(std::cbegin(sorted), std::cend(sorted),
+                                         [](auto l, auto r) {
+                                             return l.key_ == r.key_;
+                                         }) == std::cend(sorted),
+                      "Lookup keys must be unique.");
+
+        constexpr auto depth = detail::eytzinger_depth(input.size);
+        constexpr auto num_nodes = (std::size_t{1} << depth) - 1;
+
+        constexpr auto padded = [&]() {
+            std::array<entry<key_type, value_type>, num_nodes> p{};
+
+            // pad with the largest possible key: searches for it must still
+            // find the last real entry when that has the same key (or, for
+            // ranges, when it is the greatest lower bound)
+            constexpr auto pad_key = detail::max_key<key_type>();
+            auto pad_value = input.default_value;
+            if constexpr (input.size > 0) {
+                auto const last = sorted[input.size - 1];
+                if (Ranged or last.key_ == pad_key) {
+                    pad_value = last.value_;
+                }
+            }
+
+            p.fill({pad_key, pad_value});
+            std::copy(std::cbegin(sorted), std::cend(sorted), std::begin(p));
+            return p;
+        }();
+
+        constexpr auto tree = [&]() {
+            std::array<entry<key_type, value_type>, num_nodes + 1> t{};
+            t[0] = {key_type{}, input.default_value};
+            auto idx = std::size_t{};
+            detail::eytzinger_fill(padded, t, idx, 1);
+            return t;
+        }();
+
+        constexpr auto keys = [&]() {
+            std::array<key_type, num_nodes + 1> k{};
+            std::transform(std::cbegin(tree), std::cend(tree), std::begin(k),
+                           [](auto e) { return e.key_; });
+            return k;
+        }();
+
+        constexpr auto values = [&]() {
+            std::array<value_type, num_nodes + 1> v{};
+            std::transform(std::cbegin(tree), std::cend(tree), std::begin(v),
+                           [](auto e) { return e.value_; });
+            return v;
+        }();
+
+        return impl<key_type, value_type, default_value, decltype(keys),
+                    decltype(values)>{keys, values};
+    }
+};
+} // namespace lookup
@@ -1,27 +1,64 @@
 #pragma once
+#include <lookup/detail/batch.hpp>
 #include <lookup/detail/select.hpp>
 #include <lookup/input.hpp>
 #include <lookup/strategy_failed.hpp>
 
 #include <stdx/compiler.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
+#include <span>
 #include <type_traits>
 
 namespace lookup {
+namespace detail {
+template <typename Entries, typename K, typename V>
+constexpr auto find_linear(Entries const &entries, K key,
+                           V const &default_value) -> V {
+    V result = default_value;
+    for (auto [k, v] : entries) {
+        result = detail::select(key, k, v, result);
+    }
+    return result;
+}
+
+// values must be at least as long as keys; each entry is loaded once per batch
+// and compared against all of its keys
+template <typename Entries, typename K, typename V>
+constexpr auto lookup_linear(Entries const &entries, std::span<K const> keys,
+                             std::span<V> values, V const &default_value)
+    -> void {
+    detail::for_each_batch(keys, values, [&](auto ks, auto vs) {
+        std::fill(std::begin(vs), std::end(vs), default_value);
+        for (auto [k, v] : entries) {
+            for (auto i = std::size_t{}; i < ks.size(); i++) {
+                vs[i] = detail::select(ks[i], k, v, vs[i]);
+            }
+        }
+    });
+}
+} // namespace detail
+
 template <std::size_t MaxSize> struct linear_search_lookup {
   private:
     template <typename Input> struct impl : Input {
         using key_type = typename Input::key_type;
         using value_type = typename Input::value_type;
 
+        constexpr static auto max_probes = std::size_t{Input::size};
+
         [[nodiscard]] constexpr auto operator[](key_type key) const
             -> value_type {
-            value_type result = this->default_value;
-            for (auto [k, v] : this->entries) {
-                result = detail::select(key, k, v, result);
-            }
-            return result;
+            return detail::find_linear(this->entries, key,
+                                       this->default_value);
+        }
+
+        constexpr auto lookup(std::span<key_type const> keys,
+                              std::span<value_type> values) const -> void {
+            detail::lookup_linear(this->entries, keys, values,
+                                  this->default_value);
         }
     };
 
@@ -1,15 +1,48 @@
 #pragma once
 
+#include <lookup/cost.hpp>
+#include <lookup/eytzinger_lookup.hpp>
 #include <lookup/input.hpp>
 #include <lookup/linear_search_lookup.hpp>
+#include <lookup/mph_displace_lookup.hpp>
+#include <lookup/pext_lookup.hpp>
+#include <lookup/pooled_values.hpp>
 #include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/simd_linear_search_lookup.hpp>
 #include <lookup/strategies.hpp>
 
 #include <stdx/compiler.hpp>
 
+#include <type_traits>
+
 namespace lookup {
+using default_strategies =
+    strategies<linear_search_lookup<4>, pseudo_pext_lookup<true, 2>>;
+
+namespace detail {
+template <typename Policy, typename... Ts>
+using best_exact_strategy = std::conditional_t<
+    hardware_pext_available,
+    best_of<Policy, Ts..., pext_lookup<>, pext_lookup<true, 1>,
+            pext_lookup<true, 2>>,
+    best_of<Policy, Ts...>>;
+
+template <typename Policy>
+using default_best_of = best_exact_strategy<
+    Policy, linear_search_lookup<16>, simd_linear_search_lookup<64>,
+    pseudo_pext_lookup<>, pseudo_pext_lookup<true, 1>,
+    pseudo_pext_lookup<true, 2>, pseudo_pext_lookup<true, 4>,
+    mph_displace_lookup<>, eytzinger_lookup<>,
+    pooled_values<pseudo_pext_lookup<true, 2>>,
+    pooled_values<mph_displace_lookup<>>>;
+} // namespace detail
+
+template <typename Policy = optimize_for::first_fit>
 [[nodiscard]] CONSTEVAL static auto make(compile_time auto input) {
-    return strategies<linear_search_lookup<4>,
-                      pseudo_pext_lookup<true, 2>>::make(input);
+    if constexpr (std::is_same_v<Policy, optimize_for::first_fit>) {
+        return default_strategies::make(input);
+    } else {
+        return detail::default_best_of<Policy>::make(input);
+    }
 }
 } // namespace lookup
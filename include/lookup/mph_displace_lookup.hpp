@@ -0,0 +1,290 @@
+#pragma once
+
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <stdx/compiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+
+namespace lookup {
+namespace detail {
+/// splitmix64 finalizer
+constexpr auto mph_mix(std::uint64_t x) -> std::uint64_t {
+    x ^= x >> 30u;
+    x *= 0xbf58'476d'1ce4'e5b9u;
+    x ^= x >> 27u;
+    x *= 0x94d0'49bb'1331'11ebu;
+    x ^= x >> 31u;
+    return x;
+}
+
+/// reduce a raw key to the 64 bits that are hashed
+template <typename T> constexpr auto fold_key(T key) -> std::uint64_t {
+    if constexpr (sizeof(T) <= sizeof(std::uint64_t)) {
+        return static_cast<std::uint64_t>(key);
+    } else {
+        return static_cast<std::uint64_t>(key) ^
+               mph_mix(static_cast<std::uint64_t>(key >> 64u));
+    }
+}
+
+/// map h uniformly onto [0, n) without a division
+constexpr auto fastrange(std::uint32_t h, std::uint32_t n) -> std::uint32_t {
+    return static_cast<std::uint32_t>((std::uint64_t{h} * n) >> 32u);
+}
+
+struct displace_hash_t {
+    std::uint64_t seed;
+
+    [[nodiscard]] constexpr auto operator()(std::uint64_t key) const
+        -> std::uint64_t {
+        return mph_mix(key ^ seed);
+    }
+
+    [[nodiscard]] constexpr static auto bucket(std::uint64_t h,
+                                               std::uint32_t num_buckets)
+        -> std::uint32_t {
+        return fastrange(static_cast<std::uint32_t>(h >> 32u), num_buckets);
+    }
+
+    [[nodiscard]] constexpr static auto slot(std::uint64_t h,
+                                             std::uint32_t pilot,
+                                             std::uint32_t num_slots)
+        -> std::uint32_t {
+        // the multiply spreads the pilot (and the low hash bits, which differ
+        // between keys of the same bucket) into the high bits used by
+        // fastrange
+        auto const displaced = (h ^ pilot) * 0x9e37'79b9'7f4a'7c15u;
+        return fastrange(static_cast<std::uint32_t>(displaced >> 32u),
+                         num_slots);
+    }
+};
+
+template <std::size_t S, std::size_t B> struct displacement_t {
+    bool found{};
+    std::uint64_t seed{};
+    std::uint32_t max_pilot{};
+    std::array<std::uint32_t, B> pilots{};
+    std::array<std::uint32_t, S> slots{};
+};
+
+/// find a pilot per bucket such that every key lands in a distinct slot
+template <std::size_t B, typename T, std::size_t S>
+constexpr auto try_displace(std::array<T, S> const &keys, std::uint64_t seed,
+                            std::uint32_t max_pilot) -> displacement_t<S, B> {
+    auto result = displacement_t<S, B>{};
+    result.seed = seed;
+
+    auto const hash = displace_hash_t{seed};
+    constexpr auto num_buckets = static_cast<std::uint32_t>(B);
+    constexpr auto num_slots = static_cast<std::uint32_t>(S);
+
+    std::array<std::uint64_t, S> hashes{};
+    std::array<std::uint32_t, S> bucket_of{};
+    std::array<std::uint32_t, B> bucket_size{};
+    for (auto i = std::size_t{}; i < S; i++) {
+        hashes[i] = hash(fold_key(keys[i]));
+        bucket_of[i] = displace_hash_t::bucket(hashes[i], num_buckets);
+        ++bucket_size[bucket_of[i]];
+    }
+
+    // place the biggest buckets first while the table is still empty
+    std::array<std::uint32_t, S> order{};
+    for (auto i = std::size_t{}; i < S; i++) {
+        order[i] = static_cast<std::uint32_t>(i);
+    }
+    std::sort(std::begin(order), std::end(order), [&](auto l, auto r) {
+        auto const lb = bucket_of[l];
+        auto const rb = bucket_of[r];
+        if (bucket_size[lb] != bucket_size[rb]) {
+            return bucket_size[lb] > bucket_size[rb];
+        }
+        return lb < rb;
+    });
+
+    std::array<bool, S> taken{};
+    auto first = std::begin(order);
+    while (first != std::end(order)) {
+        auto const b = bucket_of[*first];
+        auto const last = std::find_if(
+            first, std::end(order), [&](auto i) { return bucket_of[i] != b; });
+
+        auto placed = false;
+        for (auto pilot = std::uint32_t{}; not placed and pilot <= max_pilot;
+             pilot++) {
+            auto it = first;
+            for (; it != last; ++it) {
+                auto const s =
+                    displace_hash_t::slot(hashes[*it], pilot, num_slots);
+                if (taken[s]) {
+                    break;
+                }
+                taken[s] = true;
+                result.slots[*it] = s;
+            }
+
+            if (it == last) {
+                placed = true;
+                result.pilots[b] = pilot;
+                result.max_pilot = std::max(result.max_pilot, pilot);
+            } else {
+                // undo the partial placement
+                for (auto undo = first; undo != it; ++undo) {
+                    taken[result.slots[*undo]] = false;
+                }
+            }
+        }
+
+        if (not placed) {
+            return result;
+        }
+        first = last;
+    }
+
+    result.found = true;
+    return result;
+}
+
+template <std::size_t B, typename T, std::size_t S>
+constexpr auto calc_displacement(std::array<T, S> const &keys,
+                                 std::uint32_t max_pilot,
+                                 std::size_t max_seeds)
+    -> displacement_t<S, B> {
+    auto result = displacement_t<S, B>{};
+    for (auto s = std::size_t{}; s < max_seeds; s++) {
+        result = try_displace<B>(keys, mph_mix(s), max_pilot);
+        if (result.found) {
+            break;
+        }
+    }
+    return result;
+}
+} // namespace detail
+
+// Two-level (bucket + pilot) minimal perfect hash in the style of CHD and
+// PTHash. Keys are hashed into buckets of about AvgBucketSize keys; each
+// bucket stores a small pilot that displaces its keys into free slots of a
+// table with exactly one slot per key. A lookup is always a single probe.
+template <std::size_t AvgBucketSize = 4,
+          std::uint32_t MaxPilot = std::numeric_limits<std::uint16_t>::max(),
+          std::size_t MaxSeeds = 8>
+struct mph_displace_lookup {
+  private:
+    static_assert(AvgBucketSize > 0);
+
+    template <typename Key, typename Value, typename Default>
+    struct empty_impl {
+        using key_type = Key;
+        using value_type = Value;
+
+        constexpr static Value default_value = Default::value;
+        constexpr static auto max_probes = std::size_t{};
+
+        [[nodiscard]] constexpr auto operator[](key_type) const -> value_type {
+            return default_value;
+        }
+    };
+
+    template <typename Key, typename Value, typename Default, typename Seed,
+              typename Pilots, typename Storage>
+    struct impl {
+        using key_type = Key;
+        using raw_key_type = detail::raw_integral_t<key_type>;
+        using value_type = Value;
+
+        constexpr static Value default_value = Default::value;
+        constexpr static auto hash = detail::displace_hash_t{Seed::value};
+        constexpr static auto num_buckets =
+            static_cast<std::uint32_t>(std::tuple_size_v<Pilots>);
+        constexpr static auto num_slots =
+            static_cast<std::uint32_t>(std::tuple_size_v<Storage>);
+        constexpr static auto max_probes = std::size_t{2};
+
+        Pilots pilots;
+        Storage storage;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            auto const raw_key = detail::as_raw_integral(key);
+            auto const h = hash(detail::fold_key(raw_key));
+            auto const pilot =
+                pilots[detail::displace_hash_t::bucket(h, num_buckets)];
+            auto const e =
+                storage[detail::displace_hash_t::slot(h, pilot, num_slots)];
+
+            if (raw_key == e.key_) {
+                return e.value_;
+            }
+
+            return default_value;
+        }
+    };
+
+    template <typename lambda> struct default_value_smuggler {
+        constexpr static auto value = lambda{}().default_value;
+    };
+
+    template <auto v> struct smuggler {
+        constexpr static auto value = v;
+    };
+
+  public:
+    [[nodiscard]] CONSTEVAL static auto make(compile_time auto i) {
+        constexpr auto input = i();
+        using key_type = typename decltype(input)::key_type;
+        using raw_key_type = detail::raw_integral_t<key_type>;
+        using value_type = typename decltype(input)::value_type;
+        using default_value = default_value_smuggler<decltype(i)>;
+
+        constexpr auto keys = detail::get_keys(input.entries);
+        static_assert(detail::keys_are_unique(keys),
+                      "Lookup keys must be unique.");
+
+        if constexpr (input.entries.empty()) {
+            return empty_impl<key_type, value_type, default_value>{};
+
+        } else {
+            constexpr auto num_buckets =
+                (input.size + AvgBucketSize - 1) / AvgBucketSize;
+            constexpr auto d = detail::calc_displacement<num_buckets>(
+                keys, MaxPilot, MaxSeeds);
+
+            if constexpr (not d.found) {
+                return strategy_failed_t{};
+
+            } else {
+                constexpr auto pilots = [&]() {
+                    using pilot_t = detail::uint_for_<d.max_pilot>;
+                    std::array<pilot_t, num_buckets> p{};
+                    std::transform(
+                        std::cbegin(d.pilots), std::cend(d.pilots),
+                        std::begin(p),
+                        [](auto pilot) { return static_cast<pilot_t>(pilot); });
+                    return p;
+                }();
+
+                constexpr auto storage = [&]() {
+                    std::array<entry<raw_key_type, value_type>, input.size> s{};
+                    for (auto idx = std::size_t{}; idx < input.size; idx++) {
+                        auto const e = input.entries[idx];
+                        s[d.slots[idx]] = {detail::as_raw_integral(e.key_),
+                                           e.value_};
+                    }
+                    return s;
+                }();
+
+                return impl<key_type, value_type, default_value,
+                            smuggler<d.seed>, decltype(pilots),
+                            decltype(storage)>{pilots, storage};
+            }
+        }
+    }
+};
+} // namespace lookup
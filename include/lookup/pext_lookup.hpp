@@ -0,0 +1,86 @@
+#pragma once
+
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace lookup {
+namespace detail {
+/// extract the bits of value selected by mask into the low bits (n)
+template <typename T>
+constexpr auto software_pext(T const value, T const mask) -> T {
+    constexpr auto t_digits = std::numeric_limits<T>::digits;
+
+    auto result = T{};
+    auto dst = std::size_t{};
+    for (auto src = std::size_t{}; src < t_digits; src++) {
+        auto const src_bit = static_cast<T>(T{1} << src);
+        if ((mask & src_bit) != 0) {
+            if ((value & src_bit) != 0) {
+                result |= static_cast<T>(T{1} << dst);
+            }
+            dst++;
+        }
+    }
+    return result;
+}
+
+template <typename T> struct pext_t {
+    T mask;
+
+    constexpr explicit pext_t(T mask_arg) : mask{mask_arg} {}
+
+    [[nodiscard]] constexpr auto operator()(T value) const -> T {
+#if defined(__BMI2__)
+        if (not std::is_constant_evaluated()) {
+            if constexpr (sizeof(T) <= sizeof(std::uint32_t)) {
+                return static_cast<T>(
+                    _pext_u32(static_cast<std::uint32_t>(value),
+                              static_cast<std::uint32_t>(mask)));
+            } else if constexpr (sizeof(T) <= sizeof(std::uint64_t)) {
+                return static_cast<T>(
+                    _pext_u64(static_cast<std::uint64_t>(value),
+                              static_cast<std::uint64_t>(mask)));
+            } else {
+                // extract each half and pack the high half above the low
+                auto const lo_mask = static_cast<std::uint64_t>(mask);
+                auto const lo =
+                    _pext_u64(static_cast<std::uint64_t>(value), lo_mask);
+                auto const hi =
+                    _pext_u64(static_cast<std::uint64_t>(value >> 64u),
+                              static_cast<std::uint64_t>(mask >> 64u));
+                return static_cast<T>(static_cast<T>(hi)
+                                      << std::popcount(lo_mask)) |
+                       static_cast<T>(lo);
+            }
+        }
+#endif
+        return software_pext(value, mask);
+    }
+};
+} // namespace detail
+
+constexpr auto hardware_pext_available =
+#if defined(__BMI2__)
+    true;
+#else
+    false;
+#endif
+
+// Like pseudo_pext_lookup, but the keys are hashed with a real parallel bit
+// extract. Because every mask bit lands in its own output bit, the mask search
+// is not limited by the multiply-and-shift packing and the minimal unique mask
+// is used as-is. On targets without BMI2 the extract falls back to a portable
+// loop; prefer pseudo_pext_lookup there (see hardware_pext_available).
+template <bool Indirect = false, std::size_t MaxSearchLen = 1>
+struct pext_lookup
+    : detail::pext_strategy<detail::pext_t, Indirect, MaxSearchLen> {};
+} // namespace lookup
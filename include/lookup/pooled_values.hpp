@@ -0,0 +1,118 @@
+#pragma once
+
+#include <lookup/cost.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <stdx/compiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace lookup {
+namespace detail {
+/// the number of distinct values, including the default (n * u)
+template <typename Input>
+constexpr auto count_unique_values(Input const &input) -> std::size_t {
+    auto count = std::size_t{1};
+    for (auto i = std::size_t{}; i < input.size; i++) {
+        auto const &v = input.entries[i].value_;
+        auto const seen =
+            v == input.default_value or
+            std::any_of(std::cbegin(input.entries),
+                        std::next(std::cbegin(input.entries),
+                                  static_cast<std::ptrdiff_t>(i)),
+                        [&](auto const &e) { return e.value_ == v; });
+        if (not seen) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/// the distinct values, with the default value first
+template <std::size_t U, typename Input>
+constexpr auto make_value_pool(Input const &input) {
+    std::array<typename Input::value_type, U> pool{};
+    pool[0] = input.default_value;
+    auto size = std::size_t{1};
+    for (auto const &e : input.entries) {
+        auto const last = std::next(std::cbegin(pool),
+                                    static_cast<std::ptrdiff_t>(size));
+        if (std::find(std::cbegin(pool), last, e.value_) == last) {
+            pool[size++] = e.value_;
+        }
+    }
+    return pool;
+}
+
+// A compile-time value (like CX_VALUE) holding the original input with each
+// value replaced by its index in the value pool.
+template <typename CxInput> struct pooled_input {
+    using cx_value_t [[maybe_unused]] = void;
+
+    constexpr static auto input = CxInput{}();
+    constexpr static auto pool =
+        make_value_pool<count_unique_values(input)>(input);
+    using index_t = uint_for_<pool.size() - 1>;
+
+    constexpr static auto index_of(auto const &v) -> index_t {
+        return static_cast<index_t>(std::distance(
+            std::cbegin(pool),
+            std::find(std::cbegin(pool), std::cend(pool), v)));
+    }
+
+    CONSTEVAL auto operator()() const noexcept {
+        using key_type = typename decltype(input)::key_type;
+        std::array<entry<key_type, index_t>, input.size> entries{};
+        std::transform(std::cbegin(input.entries), std::cend(input.entries),
+                       std::begin(entries), [](auto const &e) {
+                           return entry<key_type, index_t>{e.key_,
+                                                           index_of(e.value_)};
+                       });
+        return lookup::input<key_type, index_t, input.size>{index_t{},
+                                                            entries};
+    }
+};
+} // namespace detail
+
+// Wraps another strategy so that each distinct value is stored once, in a
+// separate pool; the wrapped lookup maps keys to a narrow index into the pool.
+// Worthwhile when values are large and many keys share the same value.
+template <typename Strategy> struct pooled_values {
+  private:
+    template <typename Inner, typename Pool> struct impl {
+        using key_type = typename Inner::key_type;
+        using value_type = typename Pool::value_type;
+
+        constexpr static auto max_probes = max_probes_v<Inner> + 1;
+
+        Inner inner;
+        Pool pool;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            return pool[inner[key]];
+        }
+    };
+
+  public:
+    [[nodiscard]] CONSTEVAL static auto make(compile_time auto i) {
+        using input_t = detail::pooled_input<decltype(i)>;
+        constexpr auto inner = Strategy::make(input_t{});
+
+        if constexpr (strategy_failed(inner)) {
+            return strategy_failed_t{};
+        } else {
+            return impl<std::remove_cvref_t<decltype(inner)>,
+                        std::remove_cvref_t<decltype(input_t::pool)>>{
+                inner, input_t::pool};
+        }
+    }
+};
+} // namespace lookup
@@ -1,11 +1,11 @@
 #pragma once
 
+#include <lookup/detail/batch.hpp>
 #include <lookup/detail/select.hpp>
+#include <lookup/entry.hpp>
 #include <lookup/input.hpp>
 #include <lookup/strategy_failed.hpp>
 
-#include <stdx/bit.hpp>
-#include <stdx/bitset.hpp>
 #include <stdx/compiler.hpp>
 #include <stdx/utility.hpp>
 
@@ -16,13 +16,22 @@
 #include <cstdint>
 #include <iterator>
 #include <limits>
+#include <span>
 #include <tuple>
+#include <type_traits>
 
 namespace lookup {
 
 namespace detail {
+#if defined(__SIZEOF_INT128__)
+__extension__ using uint128_t = unsigned __int128;
+constexpr auto max_raw_key_size = sizeof(uint128_t);
+#else
+constexpr auto max_raw_key_size = sizeof(std::uint64_t);
+#endif
+
 constexpr auto as_raw_integral(auto v) {
-    static_assert(sizeof(v) <= 8);
+    static_assert(sizeof(v) <= max_raw_key_size);
 
     if constexpr (sizeof(v) == 1) {
         return std::bit_cast<std::uint8_t>(v);
@@ -35,6 +44,10 @@ constexpr auto as_raw_integral(auto v) {
 
     } else if constexpr (sizeof(v) <= 8) {
         return std::bit_cast<std::uint64_t>(v);
+#if defined(__SIZEOF_INT128__)
+    } else {
+        return std::bit_cast<uint128_t>(v);
+#endif
     }
 }
 
@@ -59,21 +72,52 @@ template <uint64_t BiggestValue> auto uint_for_f() {
 template <uint64_t BiggestValue>
 using uint_for_ = decltype(uint_for_f<BiggestValue>());
 
+// <bit> only supports the standard unsigned types; raw keys may be 128 bits
+template <typename T> constexpr auto popcount(T v) -> int {
+    if constexpr (sizeof(T) <= sizeof(std::uint64_t)) {
+        return std::popcount(v);
+    } else {
+        return std::popcount(static_cast<std::uint64_t>(v)) +
+               std::popcount(static_cast<std::uint64_t>(v >> 64u));
+    }
+}
+
+template <typename T> constexpr auto countl_zero(T v) -> int {
+    if constexpr (sizeof(T) <= sizeof(std::uint64_t)) {
+        return std::countl_zero(v);
+    } else {
+        auto const hi = static_cast<std::uint64_t>(v >> 64u);
+        return hi != 0 ? std::countl_zero(hi)
+                       : 64 + std::countl_zero(static_cast<std::uint64_t>(v));
+    }
+}
+
+/// a mask of the lowest n bits of T
+template <typename T> constexpr auto low_bits(std::size_t n) -> T {
+    if (n >= std::numeric_limits<T>::digits) {
+        return static_cast<T>(~T{});
+    }
+    return static_cast<T>(static_cast<T>(T{1} << n) - 1u);
+}
+
+template <typename T> constexpr auto bit_is_set(T v, std::size_t i) -> bool {
+    return ((v >> i) & 1u) != 0;
+}
+
 /// log n
 template <typename T>
 constexpr auto compute_pack_coefficient(std::size_t dst, T const mask) -> T {
     constexpr auto t_digits = std::numeric_limits<T>::digits;
 
-    auto pack_coefficient = stdx::bitset<t_digits>{};
-    auto const mask_bits = stdx::bitset<t_digits>{mask};
+    auto pack_coefficient = T{};
 
     bool prev_src_bit_set = false;
     for (auto src = std::size_t{}; src < t_digits; src++) {
-        bool const curr_src_bit_set = mask_bits[src];
+        bool const curr_src_bit_set = bit_is_set(mask, src);
         bool const new_stretch = curr_src_bit_set and not prev_src_bit_set;
 
-        if (new_stretch) {
-            pack_coefficient.set(dst - src);
+        if (new_stretch and dst - src < t_digits) {
+            pack_coefficient |= static_cast<T>(T{1} << (dst - src));
         }
 
         if (curr_src_bit_set) {
@@ -83,7 +127,7 @@ constexpr auto compute_pack_coefficient(std::size_t dst, T const mask) -> T {
         prev_src_bit_set = curr_src_bit_set;
     }
 
-    return pack_coefficient.template to<T>();
+    return pack_coefficient;
 }
 
 template <typename T> struct pseudo_pext_t {
@@ -94,14 +138,13 @@ template <typename T> struct pseudo_pext_t {
 
     constexpr explicit pseudo_pext_t(T mask_arg) : mask{mask_arg} {
         constexpr auto t_digits = std::numeric_limits<T>::digits;
-        auto const num_bits_to_extract = std::popcount(mask);
-        auto const left_padding = std::countl_zero(mask);
+        auto const num_bits_to_extract = detail::popcount(mask);
+        auto const left_padding = detail::countl_zero(mask);
         gap_bits = static_cast<std::size_t>(t_digits - num_bits_to_extract -
                                             left_padding);
         coefficient = compute_pack_coefficient<T>(gap_bits, mask);
-        auto const final_mask_msb =
-            static_cast<std::size_t>(num_bits_to_extract - 1);
-        final_mask = stdx::bit_mask<T>(final_mask_msb);
+        final_mask =
+            low_bits<T>(static_cast<std::size_t>(num_bits_to_extract));
     }
 
     [[nodiscard]] constexpr auto operator()(T value) const -> T {
@@ -110,61 +153,100 @@ template <typename T> struct pseudo_pext_t {
     }
 };
 
-/// count the number of key duplicates (n log n)
-template <typename T, std::size_t S>
-constexpr auto count_duplicates(std::array<T, S> keys) -> std::size_t {
-    std::sort(std::begin(keys), std::end(keys));
-    auto dups = std::size_t{};
-    for (auto i = std::adjacent_find(std::cbegin(keys), std::cend(keys));
-         i != std::cend(keys); i = std::adjacent_find(++i, std::cend(keys))) {
-        ++dups;
-    }
-    return dups;
-}
+struct key_tally_t {
+    std::size_t duplicates;
+    std::size_t longest_run;
+};
 
-/// count the length of the longest run of identical values (n)
-template <typename T, std::size_t S>
-constexpr auto count_longest_run(std::array<T, S> keys) -> std::size_t {
-    std::sort(keys.begin(), keys.end());
+/// the size of the slots and counts used to tally n keys
+constexpr auto tally_capacity(std::size_t n) -> std::size_t {
+    return std::bit_ceil(2 * n + 2);
+}
 
-    auto longest_run = std::size_t{};
-    auto current_run = std::size_t{};
+/// count repeated keys with an open-addressing table (n expected), which is
+/// much cheaper to evaluate at compile time than sorting the keys. Callers
+/// that only need to know whether a count reaches a limit can stop early.
+/// slots and counts hold tally_capacity(keys.size()) elements and the counts
+/// must all be zero.
+template <typename T>
+constexpr auto tally_keys(
+    std::span<T const> keys, std::span<T> slots, std::span<std::size_t> counts,
+    std::size_t duplicates_limit = std::numeric_limits<std::size_t>::max(),
+    std::size_t run_limit = std::numeric_limits<std::size_t>::max())
+    -> key_tally_t {
+    auto const capacity = counts.size();
+    auto const slot_bits = static_cast<unsigned>(std::bit_width(capacity) - 1);
+    auto result = key_tally_t{};
+
+    for (auto k : keys) {
+        auto folded = static_cast<std::uint64_t>(k);
+        if constexpr (sizeof(T) > sizeof(std::uint64_t)) {
+            folded ^= static_cast<std::uint64_t>(k >> 64u);
+        }
+        auto i = static_cast<std::size_t>(
+            (folded * 0x9e37'79b9'7f4a'7c15u) >> (64u - slot_bits));
 
-    if (S > 0) {
-        T prev_value = keys[0];
+        while (counts[i] != 0 and slots[i] != k) {
+            i = (i + 1) & (capacity - 1);
+        }
 
-        for (auto i = std::size_t{1}; i < S; i++) {
-            T const curr_value = keys[i];
+        if (counts[i] == 0) {
+            slots[i] = k;
+        } else {
+            ++result.duplicates;
+        }
+        result.longest_run = std::max(result.longest_run, counts[i]);
+        ++counts[i];
 
-            if (curr_value == prev_value) {
-                current_run++;
-            }
+        if (result.duplicates >= duplicates_limit or
+            result.longest_run >= run_limit) {
+            break;
+        }
+    }
 
-            longest_run = std::max(longest_run, current_run);
+    return result;
+}
 
-            if (curr_value != prev_value) {
-                current_run = 0;
-            }
+template <typename T, std::size_t S>
+constexpr auto tally_keys(
+    std::array<T, S> const &keys,
+    std::size_t duplicates_limit = std::numeric_limits<std::size_t>::max(),
+    std::size_t run_limit = std::numeric_limits<std::size_t>::max())
+    -> key_tally_t {
+    std::array<T, tally_capacity(S)> slots{};
+    std::array<std::size_t, tally_capacity(S)> counts{};
+    return tally_keys(std::span<T const>{keys}, std::span<T>{slots},
+                      std::span<std::size_t>{counts}, duplicates_limit,
+                      run_limit);
+}
 
-            prev_value = curr_value;
-        }
-    }
+/// count the number of key duplicates (n)
+template <typename T, std::size_t S>
+constexpr auto count_duplicates(std::array<T, S> const &keys) -> std::size_t {
+    return tally_keys(keys).duplicates;
+}
 
-    return longest_run;
+/// count the length of the longest run of identical values (n)
+template <typename T, std::size_t S>
+constexpr auto count_longest_run(std::array<T, S> const &keys)
+    -> std::size_t {
+    return tally_keys(keys).longest_run;
 }
 
 template <typename T, std::size_t S>
 constexpr auto keys_are_unique(std::array<T, S> const &keys) -> bool {
-    return count_duplicates(keys) == 0;
+    return tally_keys(keys, 1).duplicates == 0;
 }
 
-template <typename T, std::size_t S>
+template <template <typename> typename PextFunc = pseudo_pext_t, typename T,
+          std::size_t S>
 constexpr auto with_mask(T const mask, std::array<T, S> const &keys)
     -> std::array<T, S> {
     std::array<T, S> new_keys{};
 
+    auto const f = PextFunc<T>(mask);
     std::transform(keys.begin(), keys.end(), new_keys.begin(),
-                   [&](T k) { return pseudo_pext_t(mask)(k); });
+                   [&](T k) { return f(k); });
 
     return new_keys;
 }
@@ -181,56 +263,83 @@ constexpr auto get_keys(std::array<entry<T, V>, S> const &entries) {
     return new_keys;
 }
 
-template <typename T, std::size_t S>
-constexpr auto remove_cheapest_bit(detail::raw_integral_t<T> mask,
-                                   std::array<T, S> keys)
-    -> detail::raw_integral_t<T> {
-    using raw_t = detail::raw_integral_t<T>;
+/// the bits that are not the same in every key
+template <typename Keys> constexpr auto varying_bits(Keys const &keys) {
+    using raw_t = std::remove_cvref_t<decltype(*std::begin(keys))>;
+    auto any_set = raw_t{};
+    auto all_set = std::numeric_limits<raw_t>::max();
+    for (auto k : keys) {
+        any_set |= k;
+        all_set &= k;
+    }
+    return static_cast<raw_t>(any_set & ~all_set);
+}
 
-    auto const t_digits = std::numeric_limits<raw_t>::digits;
-    auto bmask = stdx::bitset<t_digits>{mask};
+/// remove the bit whose removal from mask causes the fewest duplicates;
+/// tally(mask, duplicates_limit, run_limit) counts repeats among the keys
+/// hashed with mask
+template <typename T, typename Tally>
+constexpr auto remove_cheapest_bit(T const mask, Tally const &tally) -> T {
+    auto const t_digits = std::numeric_limits<T>::digits;
 
     auto cheapest_bit = std::size_t{};
     auto min_num_dups = std::numeric_limits<std::size_t>::max();
 
-    for_each(
-        [&](auto i) {
-            auto btry_mask = bmask;
-            btry_mask.reset(i);
-
-            std::array<raw_t, S> try_keys =
-                with_mask(btry_mask.template to<raw_t>(), keys);
+    for (auto i = std::size_t{}; i < t_digits; i++) {
+        if (not bit_is_set(mask, i)) {
+            continue;
+        }
 
-            auto num_dups = count_duplicates(try_keys);
-            if (num_dups < min_num_dups) {
-                min_num_dups = num_dups;
-                cheapest_bit = i;
+        auto const try_mask = static_cast<T>(mask & ~(T{1} << i));
+
+        // no need to count past the best so far
+        auto num_dups = tally(try_mask, min_num_dups,
+                              std::numeric_limits<std::size_t>::max())
+                            .duplicates;
+        if (num_dups < min_num_dups) {
+            min_num_dups = num_dups;
+            cheapest_bit = i;
+            if (num_dups == 0) {
+                break;
             }
-        },
-        bmask);
+        }
+    }
 
-    bmask.reset(cheapest_bit);
-    return bmask.template to<raw_t>();
+    return static_cast<T>(mask & ~(T{1} << cheapest_bit));
 }
 
-template <typename T, typename V, std::size_t S>
-constexpr auto calc_pseudo_pext_mask(std::array<entry<T, V>, S> const &pairs,
-                                     std::size_t max_search_len) {
-    using raw_t = detail::raw_integral_t<T>;
+/// search for a mask (and the longest run of keys sharing a hash minus one);
+/// tally is as for remove_cheapest_bit. This is shared by the compile-time
+/// strategies and the runtime builders, which provide their own storage.
+template <typename T, typename Tally>
+constexpr auto search_pext_mask(T const varying, std::size_t max_search_len,
+                                Tally const &tally)
+    -> std::tuple<T, std::size_t> {
+    auto const t_digits = std::numeric_limits<T>::digits;
+    auto const unique = [&](T m) {
+        return tally(m, 1, std::numeric_limits<std::size_t>::max())
+                   .duplicates == 0;
+    };
 
-    auto const t_digits = std::numeric_limits<raw_t>::digits;
-    std::array<raw_t, S> keys = get_keys(pairs);
+    // bits that have the same value in every key can't tell keys apart, so
+    // start from a mask of only the varying bits (if the hash keeps them
+    // unique) rather than trying to remove each constant bit in turn
+    T mask = std::numeric_limits<T>::max();
+    if (unique(varying)) {
+        mask = varying;
+    }
 
     // try removing each bit from the mask one at a time.
     // then apply the pseudo_pext function to all the keys with the mask. if
     // the keys are all still unique, then we can remove the bit and move on
     // to the next one.
-    raw_t mask = std::numeric_limits<raw_t>::max();
     for (auto x = std::size_t{}; x < t_digits; x++) {
         auto i = t_digits - 1 - x;
-        raw_t const try_mask = mask & ~static_cast<raw_t>(raw_t{1} << i);
-        std::array<raw_t, S> const try_keys = with_mask(try_mask, keys);
-        if (keys_are_unique(try_keys)) {
+        if (not bit_is_set(mask, i)) {
+            continue;
+        }
+        T const try_mask = mask & ~static_cast<T>(T{1} << i);
+        if (unique(try_mask)) {
             mask = try_mask;
         }
     }
@@ -241,9 +350,12 @@ constexpr auto calc_pseudo_pext_mask(std::array<entry<T, V>, S> const &pairs,
     // collisions. try to remove the most number of bits from the mask while
     // staying under the max search length.
     auto prev_longest_run = std::size_t{};
-    while (max_search_len > 1 && std::popcount(mask) > 4) {
-        auto try_mask = remove_cheapest_bit(mask, keys);
-        auto current_longest_run = count_longest_run(with_mask(try_mask, keys));
+    while (max_search_len > 1 && detail::popcount(mask) > 4) {
+        auto try_mask = remove_cheapest_bit(mask, tally);
+        auto current_longest_run =
+            tally(try_mask, std::numeric_limits<std::size_t>::max(),
+                  max_search_len + 1)
+                .longest_run;
         if (current_longest_run <= max_search_len) {
             mask = try_mask;
             prev_longest_run = current_longest_run;
@@ -255,10 +367,195 @@ constexpr auto calc_pseudo_pext_mask(std::array<entry<T, V>, S> const &pairs,
     return std::make_tuple(mask, prev_longest_run);
 }
 
-} // namespace detail
+template <template <typename> typename PextFunc = pseudo_pext_t, typename T,
+          typename V, std::size_t S>
+constexpr auto calc_pseudo_pext_mask(std::array<entry<T, V>, S> const &pairs,
+                                     std::size_t max_search_len) {
+    using raw_t = detail::raw_integral_t<T>;
+    std::array<raw_t, S> keys = get_keys(pairs);
 
-template <bool Indirect = false, std::size_t MaxSearchLen = 1>
-struct pseudo_pext_lookup {
+    return search_pext_mask(
+        varying_bits(keys), max_search_len,
+        [&](raw_t mask, std::size_t duplicates_limit, std::size_t run_limit) {
+            return tally_keys(with_mask<PextFunc>(mask, keys),
+                              duplicates_limit, run_limit);
+        });
+}
+
+/// order entries for the indirect strategy: grouped by hash, with the longest
+/// bucket (of at least search_len entries) placed at the end so that a search
+/// never runs off the end of the storage
+template <typename Entries, typename P>
+constexpr auto arrange_buckets(Entries &s, P const &p, std::size_t search_len)
+    -> void {
+    // sort by the hashed key to group all the buckets together
+    std::sort(std::begin(s), std::end(s), [&](auto left, auto right) {
+        return p(detail::as_raw_integral(left.key_)) <
+               p(detail::as_raw_integral(right.key_));
+    });
+
+    // find end of the longest bucket
+    auto const end_of_longest_bucket = [&]() {
+        auto e = std::begin(s);
+
+        auto curr_bucket_length = 1u;
+        auto prev_idx = p(detail::as_raw_integral(e->key_));
+        e++;
+        while (e != std::end(s)) {
+            auto const curr_idx = p(detail::as_raw_integral(e->key_));
+
+            if (curr_idx == prev_idx) {
+                curr_bucket_length++;
+
+            } else if (curr_bucket_length >= search_len) {
+                return e;
+
+            } else {
+                curr_bucket_length = 1;
+            }
+
+            prev_idx = curr_idx;
+            e++;
+        }
+
+        return e;
+    }();
+
+    // place the longest bucket at the end
+    std::rotate(std::begin(s), end_of_longest_bucket, std::end(s));
+}
+
+/// the table slot that a key hashes to (a 128-bit key's hash is 128 bits
+/// wide, but always less than the table size)
+template <typename P, typename K>
+constexpr auto slot_of(P const &p, K raw_key) -> std::size_t {
+    return static_cast<std::size_t>(p(raw_key));
+}
+
+/// point each lookup table slot at the first entry of its bucket
+template <typename Entries, typename Table, typename P>
+constexpr auto fill_lookup_table(Entries const &storage, Table &t, P const &p)
+    -> void {
+    using lookup_idx_t = std::remove_cvref_t<decltype(t[0])>;
+    std::fill(std::begin(t), std::end(t), lookup_idx_t{});
+
+    // iterate backwards so the index of the first entry of a bucket
+    // remains in the lookup table
+    for (auto entry_idx = std::size(storage); entry_idx-- > 0;) {
+        auto const raw_key = detail::as_raw_integral(storage[entry_idx].key_);
+        t[slot_of(p, raw_key)] = static_cast<lookup_idx_t>(entry_idx);
+    }
+}
+
+/// place each entry in the slot given by its hash; the other slots get the
+/// default value
+template <typename Entries, typename Storage, typename P, typename V>
+constexpr auto fill_direct_storage(Entries const &entries, Storage &s,
+                                   P const &p, V const &default_value)
+    -> void {
+    using raw_key_t = std::remove_cvref_t<decltype(s[0].key_)>;
+    std::fill(std::begin(s), std::end(s),
+              entry<raw_key_t, V>{raw_key_t{}, default_value});
+
+    for (auto e : entries) {
+        raw_key_t const k = detail::as_raw_integral(e.key_);
+        s[slot_of(p, k)] = {k, e.value_};
+    }
+}
+
+/// probe a direct table (one entry per hash value)
+template <typename P, typename Storage, typename K, typename V>
+constexpr auto find_direct(P const &p, Storage const &storage, K raw_key,
+                           V const &default_value) -> V {
+    auto const e = storage[slot_of(p, raw_key)];
+
+    if (raw_key == e.key_) {
+        return e.value_;
+    }
+
+    return default_value;
+}
+
+/// search the bucket that the lookup table gives for the key
+template <typename P, typename Table, typename Storage, typename K, typename V>
+constexpr auto find_indirect(P const &p, Table const &lookup_table,
+                             Storage const &storage, std::size_t search_len,
+                             K raw_key, V const &default_value) -> V {
+    auto i = lookup_table[slot_of(p, raw_key)];
+
+    for (auto search_count = std::size_t{}; search_count < search_len;
+         search_count++) {
+        auto const e = storage[i];
+        if (raw_key == detail::as_raw_integral(e.key_)) {
+            return e.value_;
+        }
+
+        i++;
+    }
+
+    return default_value;
+}
+
+// values must be at least as long as keys; a batch hashes all of its keys
+// (prefetching their slots) before probing any of them
+template <typename P, typename Storage, typename K, typename V>
+constexpr auto lookup_direct(P const &p, Storage const &storage,
+                             std::span<K const> keys, std::span<V> values,
+                             V const &default_value) -> void {
+    using raw_key_t = detail::raw_integral_t<K>;
+    detail::for_each_batch(keys, values, [&](auto ks, auto vs) {
+        std::array<raw_key_t, detail::batch_width> raw_keys{};
+        std::array<std::size_t, detail::batch_width> slots{};
+        for (auto i = std::size_t{}; i < ks.size(); i++) {
+            raw_keys[i] = detail::as_raw_integral(ks[i]);
+            slots[i] = slot_of(p, raw_keys[i]);
+            if (not std::is_constant_evaluated()) {
+                __builtin_prefetch(&storage[slots[i]]);
+            }
+        }
+        for (auto i = std::size_t{}; i < ks.size(); i++) {
+            auto const e = storage[slots[i]];
+            vs[i] =
+                detail::select(raw_keys[i], e.key_, e.value_, default_value);
+        }
+    });
+}
+
+// values must be at least as long as keys; a batch reads all of its lookup
+// table entries (prefetching the buckets) before searching any of the buckets
+template <typename P, typename Table, typename Storage, typename K, typename V>
+constexpr auto lookup_indirect(P const &p, Table const &lookup_table,
+                               Storage const &storage, std::size_t search_len,
+                               std::span<K const> keys, std::span<V> values,
+                               V const &default_value) -> void {
+    using raw_key_t = detail::raw_integral_t<K>;
+    detail::for_each_batch(keys, values, [&](auto ks, auto vs) {
+        std::array<raw_key_t, detail::batch_width> raw_keys{};
+        std::array<std::size_t, detail::batch_width> buckets{};
+        for (auto i = std::size_t{}; i < ks.size(); i++) {
+            raw_keys[i] = detail::as_raw_integral(ks[i]);
+            buckets[i] = lookup_table[slot_of(p, raw_keys[i])];
+            if (not std::is_constant_evaluated()) {
+                __builtin_prefetch(&storage[buckets[i]]);
+            }
+        }
+        for (auto i = std::size_t{}; i < ks.size(); i++) {
+            auto result = default_value;
+            for (auto search_count = std::size_t{}; search_count < search_len;
+                 search_count++) {
+                auto const e = storage[buckets[i] + search_count];
+                result = detail::select(raw_keys[i],
+                                        detail::as_raw_integral(e.key_),
+                                        e.value_, result);
+            }
+            vs[i] = result;
+        }
+    });
+}
+
+template <template <typename> typename Pext, bool Indirect,
+          std::size_t MaxSearchLen>
+struct pext_strategy {
   private:
     constexpr static bool use_indirect_strategy = Indirect;
     static_assert(Indirect or (not Indirect and MaxSearchLen == 1));
@@ -270,10 +567,16 @@ struct pseudo_pext_lookup {
         using value_type = Value;
 
         constexpr static Value default_value = Default::value;
+        constexpr static auto max_probes = std::size_t{};
 
         [[nodiscard]] constexpr auto operator[](key_type) const -> value_type {
             return default_value;
         }
+
+        constexpr auto lookup(std::span<key_type const> keys,
+                              std::span<value_type> values) const -> void {
+            std::fill_n(std::begin(values), keys.size(), default_value);
+        }
     };
 
     template <typename Key, typename Value, typename Default, typename PextFunc,
@@ -285,18 +588,20 @@ struct pseudo_pext_lookup {
 
         PextFunc pext_func;
         constexpr static Value default_value = Default::value;
+        constexpr static auto max_probes = std::size_t{1};
         Storage storage;
 
         [[nodiscard]] constexpr auto operator[](key_type key) const
             -> value_type {
-            auto const raw_key = detail::as_raw_integral(key);
-            auto const e = storage[pext_func(raw_key)];
-
-            if (raw_key == e.key_) {
-                return e.value_;
-            }
+            return detail::find_direct(pext_func, storage,
+                                       detail::as_raw_integral(key),
+                                       default_value);
+        }
 
-            return default_value;
+        constexpr auto lookup(std::span<key_type const> keys,
+                              std::span<value_type> values) const -> void {
+            detail::lookup_direct(pext_func, storage, keys, values,
+                                  default_value);
         }
     };
 
@@ -323,25 +628,23 @@ struct pseudo_pext_lookup {
         PextFunc pext_func;
         constexpr static Value default_value = Default::value;
         constexpr static auto search_len = SearchLen::value;
+        constexpr static auto max_probes = search_len + 1;
         LookupTable lookup_table;
         Storage storage;
 
         [[nodiscard]] constexpr auto operator[](key_type key) const
             -> value_type {
-            auto const raw_key = detail::as_raw_integral(key);
-            auto i = lookup_table[pext_func(raw_key)];
-
-            for (auto search_count = std::size_t{}; search_count < search_len;
-                 search_count++) {
-                auto const e = storage[i];
-                if (raw_key == detail::as_raw_integral(e.key_)) {
-                    return e.value_;
-                }
-
-                i++;
-            }
+            return detail::find_indirect(pext_func, lookup_table, storage,
+                                         search_len,
+                                         detail::as_raw_integral(key),
+                                         default_value);
+        }
 
-            return default_value;
+        constexpr auto lookup(std::span<key_type const> keys,
+                              std::span<value_type> values) const -> void {
+            detail::lookup_indirect(pext_func, lookup_table, storage,
+                                    search_len, keys, values,
+                                    default_value);
         }
     };
 
@@ -357,15 +660,15 @@ struct pseudo_pext_lookup {
                       "Lookup keys must be unique.");
 
         constexpr auto mask_and_search =
-            detail::calc_pseudo_pext_mask(input.entries, MaxSearchLen);
+            detail::calc_pseudo_pext_mask<Pext>(input.entries, MaxSearchLen);
 
         constexpr auto mask = std::get<0>(mask_and_search);
         constexpr auto search_len = std::get<1>(mask_and_search) + 1;
 
         using search_len_t = smuggler<search_len>;
 
-        constexpr auto p = detail::pseudo_pext_t(mask);
-        constexpr auto lookup_table_size = 1 << std::popcount(mask);
+        constexpr auto p = Pext<raw_key_type>(mask);
+        constexpr auto lookup_table_size = 1 << detail::popcount(mask);
 
         using default_value = default_value_smuggler<decltype(i)>;
 
@@ -375,64 +678,14 @@ struct pseudo_pext_lookup {
         } else if constexpr (use_indirect_strategy) {
             constexpr auto storage = [&]() {
                 auto s = input.entries;
-
-                // sort by the hashed key to group all the buckets together
-                std::sort(s.begin(), s.end(), [&](auto left, auto right) {
-                    return p(detail::as_raw_integral(left.key_)) <
-                           p(detail::as_raw_integral(right.key_));
-                });
-
-                // find end of the longest bucket
-                auto const end_of_longest_bucket = [&]() {
-                    auto e = s.begin();
-
-                    auto curr_bucket_length = 1u;
-                    auto prev_idx = p(detail::as_raw_integral(e->key_));
-                    e++;
-                    while (e != s.end()) {
-                        auto const curr_idx =
-                            p(detail::as_raw_integral(e->key_));
-
-                        if (curr_idx == prev_idx) {
-                            curr_bucket_length++;
-
-                        } else if (curr_bucket_length >= search_len) {
-                            return e;
-
-                        } else {
-                            curr_bucket_length = 1;
-                        }
-
-                        prev_idx = curr_idx;
-                        e++;
-                    }
-
-                    return e;
-                }();
-
-                // place the longest bucket at the end
-                std::rotate(s.begin(), end_of_longest_bucket, s.end());
-
+                detail::arrange_buckets(s, p, search_len);
                 return s;
             }();
 
             constexpr auto lookup_table = [&]() {
                 using lookup_idx_t = detail::uint_for_<storage.size()>;
                 std::array<lookup_idx_t, lookup_table_size> t{};
-
-                t.fill(0);
-
-                // iterate backwards so the index of the first entry of a bucket
-                // remains in the lookup table
-                for (auto entry_idx =
-                         static_cast<lookup_idx_t>(storage.size() - 1);
-                     entry_idx < storage.size(); entry_idx--) {
-                    auto const e = storage[entry_idx];
-                    auto const raw_key = detail::as_raw_integral(e.key_);
-                    auto const lookup_table_idx = p(raw_key);
-                    t[lookup_table_idx] = entry_idx;
-                }
-
+                detail::fill_lookup_table(storage, t, p);
                 return t;
             }();
 
@@ -446,13 +699,8 @@ struct pseudo_pext_lookup {
                 std::array<entry<raw_key_type, value_type>, lookup_table_size>
                     s{};
 
-                s.fill({raw_key_type{}, input.default_value});
-
-                for (auto e : input.entries) {
-                    raw_key_type const k = detail::as_raw_integral(e.key_);
-                    s[p(k)] = {k, e.value_};
-                }
-
+                detail::fill_direct_storage(input.entries, s, p,
+                                            input.default_value);
                 return s;
             }();
 
@@ -461,6 +709,11 @@ struct pseudo_pext_lookup {
         }
     }
 };
+} // namespace detail
+
+template <bool Indirect = false, std::size_t MaxSearchLen = 1>
+struct pseudo_pext_lookup
+    : detail::pext_strategy<detail::pseudo_pext_t, Indirect, MaxSearchLen> {};
 } // namespace lookup
 
 // struct always_t {
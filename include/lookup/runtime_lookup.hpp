@@ -0,0 +1,226 @@
+#pragma once
+
+#include <lookup/entry.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+
+// Lookups for data that is only known at startup (e.g. loaded from a
+// configuration). They are built into storage that the caller provides (an
+// arena, or static buffers) and never allocate; the mask search and the
+// queries share their code with the compile-time strategies.
+
+namespace lookup {
+// Looks up each key in turn in the caller's entries, as linear_search_lookup
+// does.
+template <typename K, typename V> struct runtime_linear_search_lookup {
+    using key_type = K;
+    using value_type = V;
+
+    value_type default_value{};
+    std::span<entry<K, V> const> entries{};
+
+    [[nodiscard]] constexpr auto operator[](key_type key) const
+        -> value_type {
+        return detail::find_linear(entries, key, default_value);
+    }
+
+    constexpr auto lookup(std::span<key_type const> keys,
+                          std::span<value_type> values) const -> void {
+        detail::lookup_linear(entries, keys, values, default_value);
+    }
+};
+
+// The runtime counterpart of pseudo_pext_lookup<Indirect, MaxSearchLen>. build
+// searches for a mask in the same way and lays out the table in the caller's
+// storage; it fails (returning std::nullopt) if the keys are not unique or if
+// any of the storage provided is too small. The lookup refers to that storage,
+// which must outlive it.
+template <typename K, typename V, bool Indirect = true,
+          std::size_t MaxSearchLen = 2, typename Index = std::uint32_t>
+struct runtime_pseudo_pext_lookup {
+    static_assert(Indirect or MaxSearchLen == 1);
+
+    using key_type = K;
+    using raw_key_type = detail::raw_integral_t<key_type>;
+    using value_type = V;
+    using index_type = Index;
+    using entry_type = entry<raw_key_type, value_type>;
+
+    constexpr static auto indirect = Indirect;
+
+    // working space for build, used only while building: keys and hashed
+    // hold (at least) one element per entry, slots and counts hold
+    // tally_capacity(number of entries)
+    struct scratch {
+        std::span<raw_key_type> keys;
+        std::span<raw_key_type> hashed;
+        std::span<raw_key_type> slots;
+        std::span<std::size_t> counts;
+    };
+
+    constexpr static auto tally_capacity(std::size_t n) -> std::size_t {
+        return detail::tally_capacity(n);
+    }
+
+    detail::pseudo_pext_t<raw_key_type> pext_func;
+    value_type default_value;
+    std::size_t search_len;
+    std::span<index_type const> lookup_table;
+    std::span<entry_type const> storage;
+
+    /// the indirect strategy needs storage for the entries and a lookup table
+    /// of 2^(bits in the mask) indices; the direct strategy puts
+    /// 2^(bits in the mask) entries in storage and needs no lookup table
+    [[nodiscard]] constexpr static auto
+    build(value_type const &default_value, std::span<entry<K, V> const> entries,
+          std::span<entry_type> storage, std::span<index_type> lookup_table,
+          scratch s) -> std::optional<runtime_pseudo_pext_lookup> {
+        auto const n = entries.size();
+        auto const capacity = tally_capacity(n);
+        if (s.keys.size() < n or s.hashed.size() < n or
+            s.slots.size() < capacity or s.counts.size() < capacity) {
+            return std::nullopt;
+        }
+        if (Indirect and
+            (storage.size() < n or
+             n > std::size_t{std::numeric_limits<index_type>::max()})) {
+            return std::nullopt;
+        }
+
+        auto const keys = s.keys.first(n);
+        std::transform(std::cbegin(entries), std::cend(entries),
+                       std::begin(keys),
+                       [](auto e) { return detail::as_raw_integral(e.key_); });
+
+        auto const tally = [&](std::span<raw_key_type const> ks,
+                               std::size_t duplicates_limit,
+                               std::size_t run_limit) {
+            auto const counts = s.counts.first(capacity);
+            std::fill(std::begin(counts), std::end(counts), std::size_t{});
+            return detail::tally_keys(ks, s.slots.first(capacity), counts,
+                                      duplicates_limit, run_limit);
+        };
+
+        if (tally(keys, 1, std::numeric_limits<std::size_t>::max())
+                .duplicates != 0) {
+            return std::nullopt;
+        }
+
+        auto const [mask, longest_run] = detail::search_pext_mask(
+            detail::varying_bits(keys), MaxSearchLen,
+            [&](raw_key_type m, std::size_t duplicates_limit,
+                std::size_t run_limit) {
+                auto const hashed = s.hashed.first(n);
+                auto const f = detail::pseudo_pext_t<raw_key_type>(m);
+                std::transform(std::cbegin(keys), std::cend(keys),
+                               std::begin(hashed),
+                               [&](raw_key_type k) { return f(k); });
+                return tally(hashed, duplicates_limit, run_limit);
+            });
+
+        auto const mask_bits = static_cast<std::size_t>(detail::popcount(mask));
+        if (mask_bits >= std::numeric_limits<std::size_t>::digits) {
+            return std::nullopt;
+        }
+        auto const table_size = std::size_t{1} << mask_bits;
+        auto const p = detail::pseudo_pext_t<raw_key_type>(mask);
+
+        if constexpr (Indirect) {
+            if (lookup_table.size() < table_size) {
+                return std::nullopt;
+            }
+
+            auto const search = n == 0 ? std::size_t{} : longest_run + 1;
+            auto st = storage.first(n);
+            std::transform(std::cbegin(entries), std::cend(entries),
+                           std::begin(st), [](auto e) {
+                               return entry_type{
+                                   detail::as_raw_integral(e.key_), e.value_};
+                           });
+            if (n != 0) {
+                detail::arrange_buckets(st, p, search);
+            }
+
+            auto t = lookup_table.first(table_size);
+            detail::fill_lookup_table(st, t, p);
+
+            return runtime_pseudo_pext_lookup{p, default_value, search, t, st};
+
+        } else {
+            if (storage.size() < table_size) {
+                return std::nullopt;
+            }
+
+            auto st = storage.first(table_size);
+            detail::fill_direct_storage(entries, st, p, default_value);
+
+            return runtime_pseudo_pext_lookup{p, default_value, 1, {}, st};
+        }
+    }
+
+    [[nodiscard]] constexpr auto operator[](key_type key) const
+        -> value_type {
+        auto const raw_key = detail::as_raw_integral(key);
+        if constexpr (Indirect) {
+            return detail::find_indirect(pext_func, lookup_table, storage,
+                                         search_len, raw_key, default_value);
+        } else {
+            return detail::find_direct(pext_func, storage, raw_key,
+                                       default_value);
+        }
+    }
+
+    // values must be at least as long as keys
+    constexpr auto lookup(std::span<key_type const> keys,
+                          std::span<value_type> values) const -> void {
+        if constexpr (Indirect) {
+            detail::lookup_indirect(pext_func, lookup_table, storage,
+                                    search_len, keys, values, default_value);
+        } else {
+            detail::lookup_direct(pext_func, storage, keys, values,
+                                  default_value);
+        }
+    }
+};
+
+// Fixed-size buffers for building a runtime_pseudo_pext_lookup of at most
+// Capacity entries with a mask of at most log2(TableCapacity) bits, e.g. as a
+// static object. The lookup refers to these buffers, so they must not be
+// moved or copied while it is in use.
+template <typename Lookup, std::size_t Capacity, std::size_t TableCapacity>
+struct runtime_pseudo_pext_buffers {
+    using key_type = typename Lookup::key_type;
+    using raw_key_type = typename Lookup::raw_key_type;
+    using value_type = typename Lookup::value_type;
+
+    constexpr static auto indirect = Lookup::indirect;
+    constexpr static auto tally_size = Lookup::tally_capacity(Capacity);
+
+    std::array<typename Lookup::entry_type,
+               indirect ? Capacity : TableCapacity>
+        storage{};
+    std::array<typename Lookup::index_type, indirect ? TableCapacity : 0>
+        lookup_table{};
+    std::array<raw_key_type, Capacity> keys{};
+    std::array<raw_key_type, Capacity> hashed{};
+    std::array<raw_key_type, tally_size> slots{};
+    std::array<std::size_t, tally_size> counts{};
+
+    [[nodiscard]] constexpr auto
+    build(value_type const &default_value,
+          std::span<entry<key_type, value_type> const> entries)
+        -> std::optional<Lookup> {
+        return Lookup::build(default_value, entries, storage, lookup_table,
+                             {keys, hashed, slots, counts});
+    }
+};
+} // namespace lookup
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <lookup/detail/select.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <stdx/compiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#if defined(__AVX2__) or defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace lookup {
+namespace detail {
+#if defined(__AVX2__)
+constexpr auto simd_width = std::size_t{32};
+#elif defined(__SSE2__)
+constexpr auto simd_width = std::size_t{16};
+#else
+constexpr auto simd_width = std::size_t{};
+#endif
+
+#if defined(__AVX2__) or defined(__SSE4_1__)
+constexpr auto simd_supports_64_bit_keys = true;
+#else
+constexpr auto simd_supports_64_bit_keys = false;
+#endif
+
+template <typename T>
+constexpr auto simd_supports_key =
+    simd_width != 0 and
+    (sizeof(T) <= 4 or (sizeof(T) == 8 and simd_supports_64_bit_keys));
+
+#if defined(__AVX2__) or defined(__SSE2__)
+/// compare key against simd_width bytes of keys; one mask bit per key byte
+template <typename T>
+inline auto simd_match_mask(T const *keys, T key) -> std::uint32_t {
+#if defined(__AVX2__)
+    auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(keys));
+    auto const k = [&] {
+        if constexpr (sizeof(T) == 1) {
+            return _mm256_cmpeq_epi8(v,
+                                     _mm256_set1_epi8(static_cast<char>(key)));
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm256_cmpeq_epi16(
+                v, _mm256_set1_epi16(static_cast<short>(key)));
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm256_cmpeq_epi32(v,
+                                      _mm256_set1_epi32(static_cast<int>(key)));
+        } else {
+            return _mm256_cmpeq_epi64(
+                v, _mm256_set1_epi64x(static_cast<long long>(key)));
+        }
+    }();
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(k));
+#else
+    auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(keys));
+    auto const k = [&] {
+        if constexpr (sizeof(T) == 1) {
+            return _mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(key)));
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm_cmpeq_epi16(v, _mm_set1_epi16(static_cast<short>(key)));
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm_cmpeq_epi32(v, _mm_set1_epi32(static_cast<int>(key)));
+        } else {
+#if defined(__SSE4_1__)
+            return _mm_cmpeq_epi64(
+                v, _mm_set1_epi64x(static_cast<long long>(key)));
+#endif
+        }
+    }();
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(k));
+#endif
+}
+#endif
+} // namespace detail
+
+// Like linear_search_lookup, but at runtime the key is compared against a
+// whole vector of keys at once (SSE2 or AVX2 on x86) and the matching index is
+// taken from the compare mask. Keys are padded to a whole number of vectors
+// with copies of the first key; since the lowest matching index wins, the
+// padding is never selected. Constant evaluation and targets (or key types)
+// without SIMD support use the scalar select loop.
+template <std::size_t MaxSize> struct simd_linear_search_lookup {
+  private:
+    template <typename Key, typename Value, typename Default, typename Keys,
+              typename Values>
+    struct impl {
+        using key_type = Key;
+        using raw_key_type = detail::raw_integral_t<key_type>;
+        using value_type = Value;
+
+        constexpr static Value default_value = Default::value;
+        constexpr static auto keys_per_vector =
+            std::max(detail::simd_width / sizeof(raw_key_type), std::size_t{1});
+        constexpr static auto max_probes =
+            std::tuple_size_v<Keys> / keys_per_vector;
+
+        alignas(std::max(detail::simd_width, alignof(Keys))) Keys keys;
+        Values values;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            auto const raw_key = detail::as_raw_integral(key);
+#if defined(__AVX2__) or defined(__SSE2__)
+            if constexpr (detail::simd_supports_key<raw_key_type>) {
+                if (not std::is_constant_evaluated()) {
+                    for (auto i = std::size_t{}; i < std::size(keys);
+                         i += keys_per_vector) {
+                        auto const m =
+                            detail::simd_match_mask(&keys[i], raw_key);
+                        if (m != 0) {
+                            return values[i + static_cast<std::size_t>(
+                                                  std::countr_zero(m)) /
+                                                  sizeof(raw_key_type)];
+                        }
+                    }
+                    return default_value;
+                }
+            }
+#endif
+            value_type result = default_value;
+            for (auto i = std::size_t{}; i < std::size(keys); i++) {
+                result = detail::select(raw_key, keys[i], values[i], result);
+            }
+            return result;
+        }
+    };
+
+    template <typename lambda> struct default_value_smuggler {
+        constexpr static auto value = lambda{}().default_value;
+    };
+
+  public:
+    [[nodiscard]] CONSTEVAL static auto make(compile_time auto i) {
+        constexpr auto input = i();
+        using key_type = typename decltype(input)::key_type;
+        using raw_key_type = detail::raw_integral_t<key_type>;
+        using value_type = typename decltype(input)::value_type;
+        using default_value = default_value_smuggler<decltype(i)>;
+
+        if constexpr (input.size > MaxSize) {
+            return strategy_failed_t{};
+
+        } else {
+            constexpr auto lanes = std::max(
+                detail::simd_width / sizeof(raw_key_type), std::size_t{1});
+            constexpr auto padded_size =
+                (input.size + lanes - 1) / lanes * lanes;
+
+            constexpr auto keys = [&]() {
+                std::array<raw_key_type, padded_size> k{};
+                if constexpr (input.size > 0) {
+                    k.fill(detail::as_raw_integral(input.entries[0].key_));
+                }
+                std::transform(std::cbegin(input.entries),
+                               std::cend(input.entries), std::begin(k),
+                               [](auto e) {
+                                   return detail::as_raw_integral(e.key_);
+                               });
+                return k;
+            }();
+
+            constexpr auto values = [&]() {
+                std::array<value_type, padded_size> v{};
+                if constexpr (input.size > 0) {
+                    v.fill(input.entries[0].value_);
+                }
+                std::transform(std::cbegin(input.entries),
+                               std::cend(input.entries), std::begin(v),
+                               [](auto e) { return e.value_; });
+                return v;
+            }();
+
+            return impl<key_type, value_type, default_value, decltype(keys),
+                        decltype(values)>{keys, values};
+        }
+    }
+};
+} // namespace lookup
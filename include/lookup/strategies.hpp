@@ -1,5 +1,6 @@
 #pragma once
 
+#include <lookup/cost.hpp>
 #include <lookup/input.hpp>
 #include <lookup/strategy_failed.hpp>
 
@@ -26,4 +27,34 @@ template <typename T, typename... Ts> struct strategies<T, Ts...> {
         }
     }
 };
+
+// Build every strategy and keep the one the policy says is cheapest; ties go
+// to the strategy listed first.
+template <selection_policy Policy, typename...> struct best_of;
+
+template <selection_policy Policy> struct best_of<Policy> {
+    [[nodiscard]] CONSTEVAL static auto make(compile_time auto)
+        -> strategy_failed_t {
+        return {};
+    }
+};
+
+template <selection_policy Policy, typename T, typename... Ts>
+struct best_of<Policy, T, Ts...> {
+    [[nodiscard]] CONSTEVAL static auto make(compile_time auto input) {
+        constexpr auto candidate = T::make(input);
+        constexpr auto rest = best_of<Policy, Ts...>::make(input);
+
+        if constexpr (strategy_failed(candidate)) {
+            return rest;
+        } else if constexpr (strategy_failed(rest)) {
+            return candidate;
+        } else if constexpr (Policy::cost(cost_of(rest)) <
+                             Policy::cost(cost_of(candidate))) {
+            return rest;
+        } else {
+            return candidate;
+        }
+    }
+};
 } // namespace lookup
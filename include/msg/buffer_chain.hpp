@@ -0,0 +1,185 @@
+#pragma once
+
+#include <stdx/iterator.hpp>
+#include <stdx/panic.hpp>
+#include <stdx/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace msg {
+namespace detail {
+// iterates over the elements of a buffer chain in index order
+template <typename Chain> class chain_iterator {
+    Chain chain{};
+    std::size_t index{};
+
+  public:
+    using value_type = typename Chain::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = typename Chain::element_type &;
+    using iterator_category = std::forward_iterator_tag;
+
+    constexpr chain_iterator() = default;
+    constexpr chain_iterator(Chain c, std::size_t i) : chain{c}, index{i} {}
+
+    [[nodiscard]] constexpr auto operator*() const -> reference {
+        return chain[index];
+    }
+    constexpr auto operator++() -> chain_iterator & {
+        ++index;
+        return *this;
+    }
+    constexpr auto operator++(int) -> chain_iterator {
+        auto tmp = *this;
+        ++index;
+        return tmp;
+    }
+
+  private:
+    friend constexpr auto operator==(chain_iterator const &lhs,
+                                     chain_iterator const &rhs) -> bool {
+        return lhs.index == rhs.index;
+    }
+};
+} // namespace detail
+
+/**
+ * A message's storage split over several buffers (e.g. a header and a payload
+ * received into separate DMA buffers), seen as one range without copying.
+ *
+ * The extent of each segment is fixed, so for the constant indices that field
+ * locators use, the segment holding an element is found at compile time.
+ */
+template <typename T, std::size_t... Extents> class buffer_chain {
+    static_assert(sizeof...(Extents) > 0,
+                  "A buffer chain needs at least one segment!");
+
+    // the index of the first element of each segment (and the extent)
+    constexpr static auto starts = [] {
+        auto s = std::array<std::size_t, sizeof...(Extents) + 1>{};
+        auto i = std::size_t{};
+        ((s[i + 1] = s[i] + Extents, ++i), ...);
+        return s;
+    }();
+
+    template <std::size_t I>
+    constexpr static auto segment_of =
+        static_cast<std::size_t>(
+            std::upper_bound(std::begin(starts), std::end(starts), I) -
+            std::begin(starts)) -
+        1;
+
+    std::array<T *, sizeof...(Extents)> segments{};
+
+  public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using is_chained_storage = void;
+
+    constexpr static auto extent = starts.back();
+
+    constexpr buffer_chain() = default;
+    constexpr explicit buffer_chain(stdx::span<T, Extents>... segs)
+        : segments{segs.data()...} {}
+
+    template <std::size_t I> [[nodiscard]] constexpr auto at() const -> T & {
+        static_assert(I < extent, "Index is outside the buffer chain!");
+        constexpr auto s = segment_of<I>;
+        return segments[s][I - starts[s]];
+    }
+
+    [[nodiscard]] constexpr auto operator[](std::size_t i) const -> T & {
+        auto s = std::size_t{};
+        while (i >= starts[s + 1]) {
+            ++s;
+        }
+        return segments[s][i - starts[s]];
+    }
+
+    [[nodiscard]] constexpr static auto size() -> std::size_t {
+        return extent;
+    }
+
+    [[nodiscard]] constexpr auto begin() const {
+        return detail::chain_iterator<buffer_chain>{*this, 0};
+    }
+    [[nodiscard]] constexpr auto end() const {
+        return detail::chain_iterator<buffer_chain>{*this, extent};
+    }
+};
+
+/**
+ * A buffer chain whose split is known only at runtime: each access finds its
+ * segment by walking the segments. Capacity is the (compile-time) extent of
+ * the message seen through the chain; the segments together must cover at
+ * least that many elements (constructing a shorter chain is a panic).
+ */
+template <typename T, std::size_t Capacity, std::size_t NumSegments = 2>
+class dynamic_buffer_chain {
+    static_assert(NumSegments > 0,
+                  "A buffer chain needs at least one segment!");
+
+    std::array<stdx::span<T>, NumSegments> segments{};
+
+  public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using is_chained_storage = void;
+
+    constexpr static auto extent = Capacity;
+
+    constexpr dynamic_buffer_chain() = default;
+    template <std::convertible_to<stdx::span<T>>... Segs>
+        requires(sizeof...(Segs) == NumSegments)
+    constexpr explicit dynamic_buffer_chain(Segs const &...segs)
+        : segments{stdx::span<T>{segs}...} {
+        auto total = std::size_t{};
+        for (auto const &seg : segments) {
+            total += seg.size();
+        }
+        if (total < Capacity) {
+            stdx::panic<"Buffer chain is shorter than its capacity">();
+        }
+    }
+
+    [[nodiscard]] constexpr auto operator[](std::size_t i) const -> T & {
+        for (auto s = std::size_t{}; s < NumSegments - 1; ++s) {
+            if (i < segments[s].size()) {
+                return segments[s][i];
+            }
+            i -= segments[s].size();
+        }
+        // the segments cover the capacity, so what is left is in the last one
+        return segments.back()[i];
+    }
+
+    [[nodiscard]] constexpr static auto size() -> std::size_t {
+        return extent;
+    }
+
+    [[nodiscard]] constexpr auto begin() const {
+        return detail::chain_iterator<dynamic_buffer_chain>{*this, 0};
+    }
+    [[nodiscard]] constexpr auto end() const {
+        return detail::chain_iterator<dynamic_buffer_chain>{*this, extent};
+    }
+};
+} // namespace msg
+
+namespace stdx {
+inline namespace v1 {
+template <typename T, std::size_t... Extents>
+constexpr auto ct_capacity_v<msg::buffer_chain<T, Extents...>> =
+    msg::buffer_chain<T, Extents...>::extent;
+
+template <typename T, std::size_t Capacity, std::size_t NumSegments>
+constexpr auto
+    ct_capacity_v<msg::dynamic_buffer_chain<T, Capacity, NumSegments>> =
+        Capacity;
+} // namespace v1
+} // namespace stdx
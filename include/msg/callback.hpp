@@ -3,6 +3,7 @@
 #include <log/log.hpp>
 #include <match/ops.hpp>
 #include <match/predicate.hpp>
+#include <msg/callback_stats.hpp>
 #include <msg/message.hpp>
 
 #include <stdx/concepts.hpp>
@@ -29,17 +30,28 @@ struct callback {
 
     template <stdx::ct_string Extra = "", typename... Args>
     [[nodiscard]] auto handle(auto const &data, Args &&...args) const -> bool {
+        return handle_matched<Extra>(msg::call_with_message<Msg>(matcher, data),
+                                     data, std::forward<Args>(args)...);
+    }
+
+    // as handle, when whether the matcher matches data is already known
+    template <stdx::ct_string Extra = "", typename... Args>
+    [[nodiscard]] auto handle_matched(bool matched, auto const &data,
+                                      Args &&...args) const -> bool {
         CIB_LOG_ENV(logging::get_level, logging::level::INFO);
-        if (msg::call_with_message<Msg>(matcher, data)) {
+        if (matched) {
             CIB_APPEND_LOG_ENV(typename Msg::env_t);
             CIB_LOG("Incoming message matched [{}], because [{}]{}, executing "
                     "callback",
                     stdx::cts_t<Name>{}, matcher.describe(),
                     stdx::cts_t<Extra>{});
-            msg::call_with_message<Msg>(callable, data,
-                                        std::forward<Args>(args)...);
+            stats::detail::record_call<callback>([&] {
+                msg::call_with_message<Msg>(callable, data,
+                                            std::forward<Args>(args)...);
+            });
             return true;
         }
+        stats::detail::record_mismatch<callback>();
         return false;
     }
 
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <stdx/ct_string.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Opt-in per-callback statistics. With the default (null) config, nothing is
+ * recorded and the instrumentation in callback::handle compiles away. To turn
+ * it on, specialize the config:
+ *
+ *   struct my_stats_config {
+ *       // optional: time callbacks, e.g. in CPU cycles
+ *       static auto cycles() -> std::uint64_t { return __rdtsc(); }
+ *   };
+ *   template <> inline auto msg::stats::config<> = my_stats_config{};
+ *
+ * Each callback then gets its own statically allocated counters, read with
+ * msg::stats::read(callback).
+ */
+namespace msg::stats {
+namespace null {
+struct config {};
+} // namespace null
+
+template <typename...> inline auto config = null::config{};
+
+// histogram bucket b counts calls that took [2^(b-1), 2^b) cycles; the last
+// bucket also counts anything slower
+constexpr inline auto histogram_buckets = std::size_t{32};
+
+// the counters are 64 bits wide so that they do not wrap in practice
+struct snapshot {
+    // times the callback's matcher matched and the callback was called
+    std::uint64_t hits{};
+    // times the callback's matcher was checked and did not match
+    std::uint64_t mismatches{};
+    std::array<std::uint64_t, histogram_buckets> cycles{};
+};
+
+namespace detail {
+constexpr inline auto cache_line_size = std::size_t{64};
+
+// one cache line (or more) per callback, so that callbacks handled on
+// different cores do not share counters' lines
+struct alignas(cache_line_size) counters {
+    std::atomic<std::uint64_t> hits{};
+    std::atomic<std::uint64_t> mismatches{};
+    std::array<std::atomic<std::uint64_t>, histogram_buckets> cycles{};
+};
+
+// A callback is identified by its name, its message and the type of its
+// callable; handlers that rebind a callback's matcher keep all three. So two
+// callbacks that share a name (e.g. in different services) get separate
+// counters unless they also share a message and a callable type.
+template <stdx::ct_string Name, typename Msg, typename F>
+inline counters counters_for{};
+
+template <typename Callback>
+constexpr auto &counters_of =
+    counters_for<Callback::name, typename Callback::msg_t,
+                 typename Callback::callable_t>;
+
+template <typename... Ts>
+constexpr auto enabled =
+    not std::same_as<std::remove_cvref_t<decltype(config<Ts...>)>,
+                     null::config>;
+
+template <typename... Ts>
+constexpr auto timed = requires { config<Ts...>.cycles(); };
+
+inline auto bump(std::atomic<std::uint64_t> &c) -> void {
+    c.fetch_add(1, std::memory_order_relaxed);
+}
+
+// calls f, counting (and timing) it as a hit for Callback
+template <typename Callback, typename... Ts>
+auto record_call(auto &&f) -> void {
+    if constexpr (enabled<Ts...>) {
+        auto &c = counters_of<Callback>;
+        bump(c.hits);
+        if constexpr (timed<Ts...>) {
+            auto const start = config<Ts...>.cycles();
+            std::forward<decltype(f)>(f)();
+            auto const elapsed =
+                static_cast<std::uint64_t>(config<Ts...>.cycles() - start);
+            auto const bucket = std::min(
+                static_cast<std::size_t>(std::bit_width(elapsed)),
+                histogram_buckets - 1);
+            bump(c.cycles[bucket]);
+        } else {
+            std::forward<decltype(f)>(f)();
+        }
+    } else {
+        std::forward<decltype(f)>(f)();
+    }
+}
+
+template <typename Callback, typename... Ts> auto record_mismatch() -> void {
+    if constexpr (enabled<Ts...>) {
+        bump(counters_of<Callback>.mismatches);
+    }
+}
+} // namespace detail
+
+// the counters for a callback (however a handler has rebound its matcher)
+template <typename Callback>
+[[nodiscard]] auto read(Callback const &) -> snapshot {
+    auto const &c = detail::counters_of<Callback>;
+    snapshot s{c.hits.load(std::memory_order_relaxed),
+               c.mismatches.load(std::memory_order_relaxed)};
+    for (auto i = std::size_t{}; i < histogram_buckets; ++i) {
+        s.cycles[i] = c.cycles[i].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+template <typename Callback> auto reset(Callback const &) -> void {
+    auto &c = detail::counters_of<Callback>;
+    c.hits.store(0, std::memory_order_relaxed);
+    c.mismatches.store(0, std::memory_order_relaxed);
+    for (auto &b : c.cycles) {
+        b.store(0, std::memory_order_relaxed);
+    }
+}
+} // namespace msg::stats
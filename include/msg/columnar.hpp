@@ -0,0 +1,177 @@
+#pragma once
+
+#include <msg/detail/field_words.hpp>
+#include <msg/field.hpp>
+
+#include <stdx/bit.hpp>
+#include <stdx/panic.hpp>
+#include <stdx/ranges.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace msg {
+namespace detail {
+// message buffers laid out back to back as dwords
+template <typename Buffer> struct dword_buffer {
+    constexpr static auto value = false;
+};
+template <std::size_t N> struct dword_buffer<std::array<std::uint32_t, N>> {
+    constexpr static auto value =
+        sizeof(std::array<std::uint32_t, N>) == N * sizeof(std::uint32_t);
+    constexpr static auto stride = N;
+};
+
+template <typename Field, typename Buffer>
+constexpr auto strided_column =
+    dword_buffer<std::remove_cv_t<Buffer>>::value and
+    field_dword_location<Field>::value and
+    std::integral<typename Field::value_type> and
+    not std::same_as<typename Field::value_type, bool> and
+    sizeof(typename Field::value_type) <= sizeof(std::uint32_t);
+
+template <typename Field, typename Msg>
+constexpr auto extract_one(Msg const &msg) -> typename Field::value_type {
+    if constexpr (stdx::range<Msg>) {
+        return Field::extract(msg);
+    } else {
+        return Field::extract(std::data(msg));
+    }
+}
+
+template <typename Field, typename Msg>
+constexpr auto insert_one(Msg &msg, typename Field::value_type value) -> void {
+    if constexpr (stdx::range<Msg>) {
+        Field::insert(msg, value);
+    } else {
+        Field::insert(std::data(msg), value);
+    }
+}
+
+template <typename Field, std::size_t Stride, typename V>
+auto extract_strided(std::uint32_t const *words, std::span<V> values,
+                     std::size_t n) -> void {
+    using loc_t = field_dword_location<Field>;
+    auto i = std::size_t{};
+#if defined(__AVX2__)
+    // gather the field's dword from 8 messages at a time
+    if constexpr (Stride * 7 <= static_cast<std::size_t>(
+                                    std::numeric_limits<int>::max())) {
+        constexpr auto s = static_cast<int>(Stride);
+        auto const offsets =
+            _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+        auto const mask = _mm256_set1_epi32(static_cast<int>(loc_t::mask));
+        for (; i + 8 <= n; i += 8) {
+            auto const base = reinterpret_cast<int const *>(
+                words + i * Stride + loc_t::index);
+            auto v = _mm256_i32gather_epi32(base, offsets, 4);
+            v = _mm256_and_si256(
+                _mm256_srli_epi32(v, static_cast<int>(loc_t::lsb)), mask);
+            if constexpr (sizeof(V) == sizeof(std::uint32_t)) {
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i *>(values.data() + i), v);
+            } else {
+                alignas(32) std::array<std::uint32_t, 8> lanes{};
+                _mm256_store_si256(reinterpret_cast<__m256i *>(lanes.data()),
+                                   v);
+                for (auto j = std::size_t{}; j < 8; ++j) {
+                    values[i + j] = static_cast<V>(lanes[j]);
+                }
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        auto const w = words[i * Stride + loc_t::index];
+        values[i] = static_cast<V>((w >> loc_t::lsb) & loc_t::mask);
+    }
+}
+
+template <typename Field, std::size_t Stride, typename V>
+auto insert_strided(std::uint32_t *words, std::span<V const> values,
+                    std::size_t n) -> void {
+    using loc_t = field_dword_location<Field>;
+    constexpr auto keep = ~(loc_t::mask << loc_t::lsb);
+    for (auto i = std::size_t{}; i < n; ++i) {
+        auto &w = words[i * Stride + loc_t::index];
+        auto const v = static_cast<std::uint32_t>(values[i]) & loc_t::mask;
+        w = (w & keep) | (v << loc_t::lsb);
+    }
+}
+
+// the number of messages a column covers: values must have (at least) one
+// element per message, otherwise only the messages that have one are covered
+template <typename Buffer, std::size_t N, typename V>
+constexpr auto column_size(std::span<Buffer, N> msgs, std::span<V> values)
+    -> std::size_t {
+    if (values.size() < msgs.size()) {
+        stdx::panic<"Column has fewer values than messages">();
+        return values.size();
+    }
+    return msgs.size();
+}
+} // namespace detail
+
+/**
+ * Extracts Field from each message into the corresponding element of values
+ * (which has one element per message: it is a precondition that values is
+ * no shorter than msgs). When the messages are dword arrays and
+ * the field lies within one dword, the column is read with a strided gather
+ * (8 messages at a time with AVX2); otherwise each message is extracted in
+ * turn.
+ */
+template <typename Field, typename Buffer, std::size_t N>
+auto extract_column(std::span<Buffer, N> msgs,
+                    std::span<typename Field::value_type> values) -> void {
+    auto const n = detail::column_size(msgs, values);
+    if constexpr (detail::strided_column<Field, Buffer>) {
+        if (n == 0) {
+            return;
+        }
+        constexpr auto stride =
+            detail::dword_buffer<std::remove_cv_t<Buffer>>::stride;
+        detail::extract_strided<Field, stride>(msgs.data()->data(), values,
+                                               n);
+    } else {
+        for (auto i = std::size_t{}; i < n; ++i) {
+            values[i] = detail::extract_one<Field>(msgs[i]);
+        }
+    }
+}
+
+/// Inserts each element of values into Field of the corresponding message.
+/// As for extract_column, values must be no shorter than msgs.
+template <typename Field, typename Buffer, std::size_t N>
+auto insert_column(std::span<Buffer, N> msgs,
+                   std::span<typename Field::value_type const> values)
+    -> void {
+    static_assert(not std::is_const_v<Buffer>,
+                  "Can't insert a column into const messages!");
+    static_assert(detail::is_mutable_value<Field>,
+                  "Can't change a field with a required value!");
+    auto const n = detail::column_size(msgs, values);
+    if constexpr (detail::strided_column<Field, Buffer>) {
+        if (n == 0) {
+            return;
+        }
+        constexpr auto stride = detail::dword_buffer<Buffer>::stride;
+        detail::insert_strided<Field, stride>(msgs.data()->data(), values, n);
+    } else {
+        for (auto i = std::size_t{}; i < n; ++i) {
+            detail::insert_one<Field>(msgs[i], values[i]);
+        }
+    }
+}
+} // namespace msg
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <match/concepts.hpp>
+#include <match/constant.hpp>
+#include <match/cost.hpp>
+#include <msg/decision_tree_handler.hpp>
+#include <msg/detail/decision_tree.hpp>
+#include <msg/detail/indexed_builder_common.hpp>
+#include <msg/detail/separate_sum_terms.hpp>
+#include <msg/dispatch_policy.hpp>
+#include <msg/field_matchers.hpp>
+
+#include <stdx/compiler.hpp>
+#include <stdx/ct_format.hpp>
+#include <stdx/tuple.hpp>
+#include <stdx/tuple_algorithms.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+namespace msg {
+/**
+ * A drop-in alternative to handler_builder.
+ *
+ * Rather than evaluating every callback's matcher in turn, the handler walks a
+ * decision tree built at compile time from all the callbacks' matchers. Each
+ * matcher is split into its sum-of-products terms; the tree branches on the
+ * fields that terms compare for (in)equality, most selective first. So each
+ * such field is extracted at most once, and a leaf holds only the terms that
+ * can still match. The rest of those terms' matchers (the residual) is then
+ * evaluated, cheapest first for each callback.
+ *
+ * A term that doesn't constrain a field is in every branch on that field, so
+ * the tree can grow exponentially with the number of fields. A tree larger
+ * than detail::max_tree_size is rejected at compile time; an indexed service
+ * suits such callbacks better.
+ */
+template <typename Callbacks, typename MsgBase, typename... ExtraCallbackArgs>
+struct decision_tree_builder {
+    Callbacks callbacks;
+
+    template <typename... Ts> [[nodiscard]] constexpr auto add(Ts... ts) {
+        auto new_callbacks =
+            stdx::tuple_cat(callbacks, stdx::make_tuple(ts...));
+        using new_callbacks_t = decltype(new_callbacks);
+        return decision_tree_builder<new_callbacks_t, MsgBase,
+                                     ExtraCallbackArgs...>{new_callbacks};
+    }
+
+  private:
+    using fields_t = typename detail::callback_fields<Callbacks>::type;
+    constexpr static auto num_fields = boost::mp11::mp_size<fields_t>::value;
+    constexpr static auto num_callbacks = stdx::tuple_size_v<Callbacks>;
+
+    template <typename Field>
+    constexpr static auto field_index =
+        boost::mp11::mp_find<fields_t, Field>::value;
+
+    template <typename BuilderValue> CONSTEVAL static auto all_terms() {
+        return BuilderValue::value.callbacks.apply([](auto const &...cbs) {
+            return stdx::tuple_cat(stdx::tuple<>{}, separate_sum_terms(cbs)...);
+        });
+    }
+
+    template <typename BuilderValue>
+    constexpr static auto num_terms =
+        stdx::tuple_size_v<decltype(all_terms<BuilderValue>())>;
+
+    // the term with the tree's fields removed from its matcher
+    template <typename BuilderValue, std::size_t T>
+    CONSTEVAL static auto residual() {
+        return []<typename... Fields>(stdx::type_list<Fields...>) {
+            return remove_match_terms<Fields...>(
+                all_terms<BuilderValue>()[stdx::index<T>]);
+        }(fields_t{});
+    }
+
+    template <typename BuilderValue, std::size_t T>
+    static auto match_term(MsgBase const &msg) -> bool {
+        constexpr auto cb = residual<BuilderValue, T>();
+        return cb.is_match(msg);
+    }
+
+    // called for each callback with a term in the leaf that the tree found,
+    // with whether one of those terms matched
+    template <typename BuilderValue, std::size_t I>
+    static auto invoke_callback(MsgBase const &msg, bool matched,
+                                ExtraCallbackArgs... args) -> bool {
+        constexpr auto orig_cb = BuilderValue::value.callbacks[stdx::index<I>];
+        using CB = std::remove_cvref_t<decltype(orig_cb)>;
+        constexpr auto cb =
+            typename CB::template rebind_matcher<match::always_t>{
+                match::always, orig_cb.callable};
+        constexpr auto matcher_str =
+            stdx::ct_format<" (decided by tree from [{}])">(
+                orig_cb.matcher.describe());
+        return cb.template handle_matched<matcher_str>(matched, msg, args...);
+    }
+
+    // terms are numbered in callback order and then by the cost of their
+    // residual matchers
+    template <typename BuilderValue, std::size_t... Ts>
+    CONSTEVAL static auto term_ranks(std::index_sequence<Ts...>) {
+        constexpr auto n = sizeof...(Ts);
+        std::array<std::size_t, n> owners{};
+        BuilderValue::value.callbacks.apply([&](auto const &...cbs) {
+            auto t = std::size_t{};
+            auto i = std::size_t{};
+            (
+                [&] {
+                    constexpr auto count =
+                        stdx::tuple_size_v<decltype(separate_sum_terms(cbs))>;
+                    for (auto j = std::size_t{}; j < count; ++j) {
+                        owners[t++] = i;
+                    }
+                    ++i;
+                }(),
+                ...);
+        });
+        std::array<std::size_t, n> costs{
+            match::cost(std::type_identity<
+                        typename decltype(residual<BuilderValue, Ts>())::
+                            matcher_t>{})...};
+
+        std::array<std::size_t, n> order{};
+        std::iota(std::begin(order), std::end(order), std::size_t{});
+        std::sort(std::begin(order), std::end(order), [&](auto l, auto r) {
+            if (owners[l] != owners[r]) {
+                return owners[l] < owners[r];
+            }
+            if (costs[l] != costs[r]) {
+                return costs[l] < costs[r];
+            }
+            return l < r;
+        });
+
+        struct {
+            std::array<std::size_t, n> rank{};
+            std::array<std::size_t, n> owner{};
+        } result{};
+        for (auto r = std::size_t{}; r < n; ++r) {
+            result.rank[order[r]] = r;
+            result.owner[r] = owners[order[r]];
+        }
+        return result;
+    }
+
+    template <typename BuilderValue> CONSTEVAL static auto ranks() {
+        return term_ranks<BuilderValue>(
+            std::make_index_sequence<num_terms<BuilderValue>>{});
+    }
+
+    template <typename BuilderValue> CONSTEVAL static auto num_negatives() {
+        auto n = std::size_t{};
+        stdx::for_each(
+            [&](auto const &term) {
+                index_not_terms(term.matcher,
+                                [&]<typename Field>(std::size_t, auto) {
+                                    if constexpr (field_index<Field> <
+                                                  num_fields) {
+                                        ++n;
+                                    }
+                                },
+                                std::size_t{});
+            },
+            all_terms<BuilderValue>());
+        return n;
+    }
+
+    template <typename BuilderValue> CONSTEVAL static auto tree_terms() {
+        constexpr auto r = ranks<BuilderValue>();
+        detail::tree_terms<num_fields, num_terms<BuilderValue>,
+                           num_negatives<BuilderValue>()>
+            terms{};
+        auto idx = std::size_t{};
+        auto neg = std::size_t{};
+        stdx::for_each(
+            [&](auto const &term) {
+                auto const t = r.rank[idx++];
+                index_terms(term.matcher,
+                            [&]<typename Field>(std::size_t, auto value) {
+                                if constexpr (field_index<Field> <
+                                              num_fields) {
+                                    terms.add_eq(
+                                        field_index<Field>, t,
+                                        static_cast<std::uint64_t>(value));
+                                }
+                            },
+                            t);
+                index_not_terms(term.matcher,
+                                [&]<typename Field>(std::size_t, auto value) {
+                                    if constexpr (field_index<Field> <
+                                                  num_fields) {
+                                        terms.negs[neg++] = {
+                                            field_index<Field>, t,
+                                            static_cast<std::uint64_t>(value)};
+                                    }
+                                },
+                                t);
+            },
+            all_terms<BuilderValue>());
+        terms.order_levels();
+        return terms;
+    }
+
+    template <typename BuilderValue> CONSTEVAL static auto all_term_set() {
+        detail::term_set_t<num_terms<BuilderValue>> s{};
+        for (auto t = std::size_t{}; t < num_terms<BuilderValue>; ++t) {
+            s.set(t);
+        }
+        return s;
+    }
+
+    template <typename BuilderValue> CONSTEVAL static auto build_tree() {
+        constexpr auto terms = tree_terms<BuilderValue>();
+        constexpr auto size = [&] {
+            detail::tree_size_t sz{};
+            terms.visit(0, all_term_set<BuilderValue>(), sz);
+            return sz;
+        }();
+        static_assert(not size.full(),
+                      "The decision tree for these callbacks is too large: use "
+                      "an indexed service instead!");
+        detail::decision_tree<size.num_inner, size.num_keys, size.num_leaves,
+                              num_terms<BuilderValue>>
+            tree{};
+        auto fill = detail::tree_fill_t<decltype(tree)>{tree};
+        terms.visit(0, all_term_set<BuilderValue>(), fill);
+        return tree;
+    }
+
+    template <typename BuilderValue, std::size_t... Ts, std::size_t... Is>
+    CONSTEVAL static auto build_dispatch(std::index_sequence<Ts...>,
+                                         std::index_sequence<Is...>) {
+        constexpr auto r = ranks<BuilderValue>();
+        using dispatch_t =
+            detail::tree_dispatch<sizeof...(Ts), sizeof...(Is), MsgBase,
+                                  ExtraCallbackArgs...>;
+        dispatch_t d{{}, r.owner, {invoke_callback<BuilderValue, Is>...}};
+        ((d.terms[r.rank[Ts]] = match_term<BuilderValue, Ts>), ...);
+        return d;
+    }
+
+  public:
+    template <typename BuilderValue, typename Policy = dispatch_all>
+    CONSTEVAL static auto build() {
+        constexpr auto tree = build_tree<BuilderValue>();
+        constexpr auto dispatch = build_dispatch<BuilderValue>(
+            std::make_index_sequence<num_terms<BuilderValue>>{},
+            std::make_index_sequence<num_callbacks>{});
+        return decision_tree_handler<fields_t, decltype(tree),
+                                     decltype(dispatch), Callbacks, Policy,
+                                     MsgBase, ExtraCallbackArgs...>{
+            tree, dispatch, BuilderValue::value.callbacks};
+    }
+};
+} // namespace msg
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <msg/detail/decision_tree.hpp>
+#include <msg/detail/log_unhandled.hpp>
+#include <msg/dispatch_policy.hpp>
+#include <msg/handler_interface.hpp>
+
+#include <stdx/ranges.hpp>
+#include <stdx/tuple.hpp>
+#include <stdx/tuple_algorithms.hpp>
+#include <stdx/utility.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <span>
+
+namespace msg {
+namespace detail {
+template <typename Field, typename Msg>
+constexpr auto extract_tree_key(Msg const &msg) -> std::uint64_t {
+    if constexpr (stdx::range<Msg>) {
+        return static_cast<std::uint64_t>(Field::extract(msg));
+    } else {
+        return static_cast<std::uint64_t>(Field::extract(std::data(msg)));
+    }
+}
+
+/// the value of the idx'th field
+template <typename... Fields, typename Msg>
+constexpr auto extract_tree_key(stdx::type_list<Fields...>, std::size_t idx,
+                                Msg const &msg) -> std::uint64_t {
+    auto value = std::uint64_t{};
+    auto i = std::size_t{};
+    (void)((i++ == idx and
+            (value = extract_tree_key<Fields>(msg), true)) or
+           ...);
+    return value;
+}
+
+// The functions that the leaves of the tree dispatch to: terms[t] evaluates
+// what is left of term t's matcher once the tree has decided its path,
+// owners[t] is the callback that term t came from, and callbacks[i] runs
+// callback i if it matched (and otherwise records its mismatch).
+template <std::size_t NumTerms, std::size_t NumCallbacks, typename MsgBase,
+          typename... ExtraCallbackArgs>
+struct tree_dispatch {
+    using term_func_t = auto (*)(MsgBase const &) -> bool;
+    using callback_func_t = auto (*)(MsgBase const &, bool,
+                                     ExtraCallbackArgs...) -> bool;
+
+    std::array<term_func_t, NumTerms> terms;
+    std::array<std::size_t, NumTerms> owners;
+    std::array<callback_func_t, NumCallbacks> callbacks;
+};
+} // namespace detail
+
+// Dispatches through a decision tree compiled from all of the callbacks'
+// matchers (see decision_tree_builder). Each callback runs at most once, as
+// with handler, even when several terms of its matcher match. With a
+// first-match Policy, only the first matching callback (in registration
+// order) runs.
+template <typename Fields, typename Tree, typename Dispatch, typename Callbacks,
+          typename Policy, typename MsgBase, typename... ExtraCallbackArgs>
+struct decision_tree_handler
+    : handler_interface<MsgBase, ExtraCallbackArgs...> {
+    using base_t = handler_interface<MsgBase, ExtraCallbackArgs...>;
+    constexpr static auto num_callbacks = stdx::tuple_size_v<Callbacks>;
+
+    Tree tree;
+    Dispatch dispatch;
+    Callbacks callbacks;
+
+    constexpr decision_tree_handler(Tree t, Dispatch d, Callbacks cbs)
+        : tree{t}, dispatch{d}, callbacks{cbs} {}
+
+    auto is_match(MsgBase const &msg) const -> bool final {
+        return leaf_callbacks(msg).matched.any();
+    }
+
+    __attribute__((flatten)) auto handle(MsgBase const &msg,
+                                         ExtraCallbackArgs... args) const
+        -> bool final {
+        auto const cbs = leaf_callbacks(msg);
+        auto handled = false;
+        if constexpr (Policy::first_match) {
+            // candidates are tried in registration order until one matches
+            for (auto i = std::size_t{}; i < num_callbacks and not handled;
+                 ++i) {
+                if (cbs.candidates[i]) {
+                    handled =
+                        dispatch.callbacks[i](msg, cbs.matched[i], args...);
+                }
+            }
+        } else {
+            handled = transform_reduce(
+                [&](auto i) -> bool {
+                    return dispatch.callbacks[i](msg, cbs.matched[i], args...);
+                },
+                std::logical_or{}, false, cbs.candidates);
+        }
+
+        if (not handled) [[unlikely]] {
+            detail::log_unhandled(callbacks, msg);
+        }
+        return handled;
+    }
+
+    // The leaves (and which of their terms match) are found for a whole chunk
+    // of messages; then each candidate callback runs over the messages it is a
+    // candidate for. As with the other handlers, a first-match handler
+    // handles the messages one at a time.
+    __attribute__((flatten)) auto handle_batch(std::span<MsgBase const> msgs,
+                                               ExtraCallbackArgs... args) const
+        -> std::size_t final {
+        if constexpr (Policy::first_match) {
+            return base_t::handle_batch(msgs, args...);
+        } else {
+            auto num_handled = std::size_t{};
+            for (auto first = std::size_t{}; first < msgs.size();
+                 first += detail::batch_chunk_size) {
+                auto const chunk = msgs.subspan(
+                    first,
+                    std::min(detail::batch_chunk_size, msgs.size() - first));
+
+                std::array<leaf_result, detail::batch_chunk_size> leaves{};
+                auto any_candidates = detail::term_set_t<num_callbacks>{};
+                for (auto i = std::size_t{}; i < chunk.size(); ++i) {
+                    leaves[i] = leaf_callbacks(chunk[i]);
+                    any_candidates = any_candidates | leaves[i].candidates;
+                }
+
+                std::array<bool, detail::batch_chunk_size> handled{};
+                for_each(
+                    [&](auto cb) {
+                        for (auto i = std::size_t{}; i < chunk.size(); ++i) {
+                            if (leaves[i].candidates[cb]) {
+                                handled[i] = dispatch.callbacks[cb](
+                                                 chunk[i],
+                                                 leaves[i].matched[cb],
+                                                 args...) or
+                                             handled[i];
+                            }
+                        }
+                    },
+                    any_candidates);
+
+                for (auto i = std::size_t{}; i < chunk.size(); ++i) {
+                    if (handled[i]) [[likely]] {
+                        ++num_handled;
+                    } else {
+                        detail::log_unhandled(callbacks, chunk[i]);
+                    }
+                }
+            }
+            return num_handled;
+        }
+    }
+
+  private:
+    // the callbacks with a term in msg's leaf, and those that matched
+    struct leaf_result {
+        detail::term_set_t<num_callbacks> candidates{};
+        detail::term_set_t<num_callbacks> matched{};
+    };
+
+    [[nodiscard]] auto leaf_callbacks(MsgBase const &msg) const
+        -> leaf_result {
+        auto const &leaf = tree.find_leaf([&](std::size_t field) {
+            return detail::extract_tree_key(Fields{}, field, msg);
+        });
+
+        auto result = leaf_result{};
+        for_each(
+            [&](auto t) {
+                auto const owner = dispatch.owners[t];
+                result.candidates.set(owner);
+                if (not result.matched[owner] and dispatch.terms[t](msg)) {
+                    result.matched.set(owner);
+                }
+            },
+            leaf);
+        return result;
+    }
+};
+} // namespace msg
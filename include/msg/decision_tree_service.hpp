@@ -0,0 +1,23 @@
+#pragma once
+
+#include <msg/decision_tree_builder.hpp>
+#include <msg/handler_interface.hpp>
+
+#include <stdx/compiler.hpp>
+#include <stdx/tuple.hpp>
+
+namespace msg {
+template <typename MsgBase, typename... ExtraCallbackArgs>
+struct decision_tree_service {
+    using builder_t =
+        decision_tree_builder<stdx::tuple<>, MsgBase, ExtraCallbackArgs...>;
+    using interface_t =
+        handler_interface<MsgBase, ExtraCallbackArgs...> const *;
+
+    constexpr static auto uninitialized_v =
+        uninitialized_handler_t<MsgBase, ExtraCallbackArgs...>{};
+    CONSTEVAL static auto uninitialized() -> interface_t {
+        return &uninitialized_v;
+    }
+};
+} // namespace msg
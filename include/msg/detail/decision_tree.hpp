@@ -0,0 +1,277 @@
+#pragma once
+
+#include <stdx/bitset.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace msg::detail {
+// The decision tree is built over "terms": the products of the callbacks'
+// sum-of-products matchers. Each term may constrain a field to be equal to a
+// value (or not equal to some values); the tree branches on those fields and
+// each leaf holds the terms that may still match once its path is decided.
+
+// Terms that don't constrain a field are copied into every branch on it, so a
+// tree can have exponentially many nodes. Sizing a tree stops once it has
+// more nodes and leaves than this, and the builder then rejects it.
+constexpr inline auto max_tree_size = std::size_t{1} << 10u;
+
+struct tree_eq_t {
+    bool constrained{};
+    bool conflict{}; // constrained to two different values: never matches
+    std::uint64_t value{};
+};
+
+struct tree_neg_t {
+    std::size_t field{};
+    std::size_t term{};
+    std::uint64_t value{};
+};
+
+struct tree_node_t {
+    std::size_t field{};
+    std::size_t first_key{};
+    std::size_t num_keys{};
+    std::size_t default_child{};
+};
+
+template <std::size_t NumTerms>
+using term_set_t = stdx::bitset<std::max(NumTerms, std::size_t{1})>;
+
+template <std::size_t NumFields, std::size_t NumTerms, std::size_t NumNegs>
+struct tree_terms {
+    using set_t = term_set_t<NumTerms>;
+
+    std::array<std::array<tree_eq_t, NumTerms>, NumFields> eqs{};
+    std::array<tree_neg_t, NumNegs> negs{};
+    std::array<std::size_t, NumFields> levels{}; // the field at each level
+    std::size_t num_levels{};
+
+    constexpr auto add_eq(std::size_t field, std::size_t term,
+                          std::uint64_t value) -> void {
+        auto &eq = eqs[field][term];
+        eq.conflict = eq.conflict or (eq.constrained and eq.value != value);
+        eq.constrained = true;
+        eq.value = value;
+    }
+
+    // fields are ordered by selectivity: those that constrain the most terms
+    // (so that the fewest terms are copied into every branch) and then those
+    // with the most distinct values come first
+    constexpr auto order_levels() -> void {
+        std::array<std::size_t, NumFields> constrained{};
+        std::array<std::size_t, NumFields> distinct{};
+        for (auto f = std::size_t{}; f < NumFields; ++f) {
+            std::array<std::uint64_t, NumTerms> values{};
+            auto n = std::size_t{};
+            for (auto const &eq : eqs[f]) {
+                if (eq.constrained) {
+                    values[n++] = eq.value;
+                }
+            }
+            for (auto const &neg : negs) {
+                constrained[f] += neg.field == f ? 1u : 0u;
+            }
+            constrained[f] += n;
+            auto const first = std::begin(values);
+            auto const last = std::next(first, static_cast<std::ptrdiff_t>(n));
+            std::sort(first, last);
+            distinct[f] = static_cast<std::size_t>(
+                std::distance(first, std::unique(first, last)));
+            if (constrained[f] != 0) {
+                levels[num_levels++] = f;
+            }
+        }
+        std::sort(std::begin(levels),
+                  std::next(std::begin(levels),
+                            static_cast<std::ptrdiff_t>(num_levels)),
+                  [&](auto l, auto r) {
+                      if (constrained[l] != constrained[r]) {
+                          return constrained[l] > constrained[r];
+                      }
+                      if (distinct[l] != distinct[r]) {
+                          return distinct[l] > distinct[r];
+                      }
+                      return l < r;
+                  });
+    }
+
+    [[nodiscard]] constexpr auto constrains(std::size_t field,
+                                            set_t const &s) const -> bool {
+        for (auto t = std::size_t{}; t < NumTerms; ++t) {
+            if (s[t] and eqs[field][t].constrained) {
+                return true;
+            }
+        }
+        return std::any_of(std::cbegin(negs), std::cend(negs), [&](auto n) {
+            return n.field == field and s[n.term];
+        });
+    }
+
+    [[nodiscard]] constexpr auto excluded(std::size_t field, std::size_t term,
+                                          std::uint64_t value) const -> bool {
+        return std::any_of(std::cbegin(negs), std::cend(negs), [&](auto n) {
+            return n.field == field and n.term == term and n.value == value;
+        });
+    }
+
+    // build the (sub)tree for the terms in s from the given level: sink
+    // receives the nodes and leaves and returns their ids
+    template <typename Sink>
+    constexpr auto visit(std::size_t level, set_t const &s, Sink &sink) const
+        -> std::size_t {
+        if (sink.full()) {
+            return sink.leaf(s);
+        }
+        while (level < num_levels and not constrains(levels[level], s)) {
+            ++level;
+        }
+        if (level == num_levels or s.none()) {
+            return sink.leaf(s);
+        }
+
+        auto const field = levels[level];
+        std::array<std::size_t, NumTerms> members{};
+        auto num_members = std::size_t{};
+        std::array<std::uint64_t, NumTerms + NumNegs> keys{};
+        auto num_keys = std::size_t{};
+        for (auto t = std::size_t{}; t < NumTerms; ++t) {
+            if (s[t]) {
+                members[num_members++] = t;
+                auto const &eq = eqs[field][t];
+                if (eq.constrained and not eq.conflict) {
+                    keys[num_keys++] = eq.value;
+                }
+            }
+        }
+        for (auto const &n : negs) {
+            if (n.field == field and s[n.term]) {
+                keys[num_keys++] = n.value;
+            }
+        }
+        auto const first_key = std::begin(keys);
+        auto const last_key =
+            std::next(first_key, static_cast<std::ptrdiff_t>(num_keys));
+        std::sort(first_key, last_key);
+        num_keys = static_cast<std::size_t>(
+            std::distance(first_key, std::unique(first_key, last_key)));
+
+        auto const node = sink.inner(field, num_keys);
+        for (auto k = std::size_t{}; k < num_keys; ++k) {
+            set_t child{};
+            for (auto m = std::size_t{}; m < num_members; ++m) {
+                auto const t = members[m];
+                auto const &eq = eqs[field][t];
+                if ((not eq.constrained or
+                     (not eq.conflict and eq.value == keys[k])) and
+                    not excluded(field, t, keys[k])) {
+                    child.set(t);
+                }
+            }
+            sink.key(node, k, keys[k], visit(level + 1, child, sink));
+        }
+
+        // a value that isn't a key satisfies every inequality
+        set_t fallback{};
+        for (auto m = std::size_t{}; m < num_members; ++m) {
+            if (not eqs[field][members[m]].constrained) {
+                fallback.set(members[m]);
+            }
+        }
+        sink.fallback(node, visit(level + 1, fallback, sink));
+        return sink.id(node);
+    }
+};
+
+struct tree_size_t {
+    std::size_t num_inner{};
+    std::size_t num_keys{};
+    std::size_t num_leaves{};
+
+    // too large: the rest of the tree is not visited
+    [[nodiscard]] constexpr auto full() const -> bool {
+        return num_inner + num_leaves > max_tree_size;
+    }
+
+    constexpr auto inner(std::size_t, std::size_t n) -> std::size_t {
+        num_keys += n;
+        return num_inner++;
+    }
+    constexpr auto key(std::size_t, std::size_t, std::uint64_t, std::size_t)
+        -> void {}
+    constexpr auto fallback(std::size_t, std::size_t) -> void {}
+    constexpr auto id(std::size_t) -> std::size_t { return {}; }
+    template <typename S> constexpr auto leaf(S const &) -> std::size_t {
+        ++num_leaves;
+        return {};
+    }
+};
+
+// Inner nodes are numbered in pre-order (so the root is node 0); leaf i has
+// the id NumInner + i.
+template <std::size_t NumInner, std::size_t NumKeys, std::size_t NumLeaves,
+          std::size_t NumTerms>
+struct decision_tree {
+    using set_t = term_set_t<NumTerms>;
+
+    std::array<tree_node_t, NumInner> nodes{};
+    std::array<std::uint64_t, NumKeys> keys{};
+    std::array<std::size_t, NumKeys> children{};
+    std::array<set_t, NumLeaves> leaves{};
+
+    /// follow the path chosen by field_value(field) to a leaf: each field is
+    /// asked for at most once
+    template <typename F>
+    [[nodiscard]] constexpr auto find_leaf(F const &field_value) const
+        -> set_t const & {
+        auto n = std::size_t{};
+        while (n < NumInner) {
+            auto const &node = nodes[n];
+            auto const value = field_value(node.field);
+            auto const first = std::next(
+                std::cbegin(keys), static_cast<std::ptrdiff_t>(node.first_key));
+            auto const last =
+                std::next(first, static_cast<std::ptrdiff_t>(node.num_keys));
+            auto const it = std::lower_bound(first, last, value);
+            n = it != last and *it == value
+                    ? children[static_cast<std::size_t>(
+                          std::distance(std::cbegin(keys), it))]
+                    : node.default_child;
+        }
+        return leaves[n - NumInner];
+    }
+};
+
+template <typename Tree> struct tree_fill_t {
+    Tree &tree;
+    std::size_t next_inner{};
+    std::size_t next_key{};
+    std::size_t next_leaf{};
+
+    [[nodiscard]] constexpr static auto full() -> bool { return false; }
+
+    constexpr auto inner(std::size_t field, std::size_t num_keys)
+        -> std::size_t {
+        tree.nodes[next_inner] = {field, next_key, num_keys, 0};
+        next_key += num_keys;
+        return next_inner++;
+    }
+    constexpr auto key(std::size_t node, std::size_t i, std::uint64_t k,
+                       std::size_t child) -> void {
+        auto const idx = tree.nodes[node].first_key + i;
+        tree.keys[idx] = k;
+        tree.children[idx] = child;
+    }
+    constexpr auto fallback(std::size_t node, std::size_t child) -> void {
+        tree.nodes[node].default_child = child;
+    }
+    constexpr auto id(std::size_t node) -> std::size_t { return node; }
+    template <typename S> constexpr auto leaf(S const &s) -> std::size_t {
+        tree.leaves[next_leaf] = s;
+        return std::size(tree.nodes) + next_leaf++;
+    }
+};
+} // namespace msg::detail
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <match/and.hpp>
+#include <match/constant.hpp>
+#include <match/not.hpp>
+#include <match/or.hpp>
+#include <msg/field_matchers.hpp>
+
+#include <stdx/bitset.hpp>
+#include <stdx/ranges.hpp>
+#include <stdx/tuple.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace msg::detail {
+// The fields that a matcher reads (once for each time it reads them), when it
+// is made only of field comparisons, so that it can be evaluated against a
+// field_cache.
+template <typename M> struct cacheable_fields {
+    constexpr static auto value = false;
+    using type = stdx::type_list<>;
+};
+
+template <> struct cacheable_fields<match::always_t> {
+    constexpr static auto value = true;
+    using type = stdx::type_list<>;
+};
+
+template <> struct cacheable_fields<match::never_t> {
+    constexpr static auto value = true;
+    using type = stdx::type_list<>;
+};
+
+template <typename RelOp, typename Field, typename Field::type X>
+struct cacheable_fields<rel_matcher_t<RelOp, Field, X>> {
+    constexpr static auto value =
+        std::is_default_constructible_v<typename Field::value_type>;
+    using type = stdx::type_list<Field>;
+};
+
+template <typename M>
+struct cacheable_fields<match::not_t<M>> : cacheable_fields<M> {};
+
+template <typename L, typename R> struct cacheable_binary_fields {
+    constexpr static auto value =
+        cacheable_fields<L>::value and cacheable_fields<R>::value;
+    using type = boost::mp11::mp_append<typename cacheable_fields<L>::type,
+                                        typename cacheable_fields<R>::type>;
+};
+
+template <typename L, typename R>
+struct cacheable_fields<match::and_t<L, R>> : cacheable_binary_fields<L, R> {};
+template <typename L, typename R>
+struct cacheable_fields<match::or_t<L, R>> : cacheable_binary_fields<L, R> {};
+
+template <typename M>
+constexpr auto cacheable_matcher = cacheable_fields<M>::value;
+
+template <typename M>
+using cached_fields_t =
+    std::conditional_t<cacheable_matcher<M>, typename cacheable_fields<M>::type,
+                       stdx::type_list<>>;
+
+// of the fields read by the matchers, those read more than once
+template <typename... Ms> struct shared_fields {
+    using all_t =
+        boost::mp11::mp_append<stdx::type_list<>, cached_fields_t<Ms>...>;
+    template <typename Field>
+    using repeated = boost::mp11::mp_bool<(
+        boost::mp11::mp_count<all_t, Field>::value > 1)>;
+    using type =
+        boost::mp11::mp_copy_if<boost::mp11::mp_unique<all_t>, repeated>;
+};
+
+/**
+ * A message together with a cache of some of its fields, shared by all the
+ * callbacks considered for one message. Each cached field is extracted the
+ * first time it is read; other fields are extracted every time.
+ */
+template <typename MsgBase, typename Fields> class field_cache;
+
+template <typename MsgBase, typename... Fields>
+class field_cache<MsgBase, stdx::type_list<Fields...>> {
+    using fields_t = stdx::type_list<Fields...>;
+    constexpr static auto num_fields = sizeof...(Fields);
+
+    MsgBase const &base;
+    mutable stdx::tuple<typename Fields::value_type...> values{};
+    mutable stdx::bitset<std::max(num_fields, std::size_t{1})> extracted{};
+
+    template <typename Field> constexpr auto extract() const {
+        if constexpr (stdx::range<MsgBase>) {
+            return Field::extract(base);
+        } else {
+            return Field::extract(std::data(base));
+        }
+    }
+
+  public:
+    using is_field_cache = void;
+
+    constexpr explicit field_cache(MsgBase const &msg) : base{msg} {}
+
+    [[nodiscard]] constexpr auto message() const -> MsgBase const & {
+        return base;
+    }
+
+    template <typename Field>
+    [[nodiscard]] constexpr auto get() const -> typename Field::value_type {
+        constexpr auto i = boost::mp11::mp_find<fields_t, Field>::value;
+        if constexpr (i == num_fields) {
+            return extract<Field>();
+        } else {
+            if (not extracted[i]) {
+                values[stdx::index<i>] = extract<Field>();
+                extracted.set(i);
+            }
+            return values[stdx::index<i>];
+        }
+    }
+};
+
+// what a handler passes its callback entries: a field_cache over the message
+// when the entries take one, otherwise the message itself
+template <typename F> struct dispatch_arg {
+    using type = void;
+};
+template <typename R, typename A, typename... Args>
+struct dispatch_arg<R (*)(A, Args...)> {
+    using type = std::remove_cvref_t<A>;
+};
+
+template <typename Callbacks>
+using dispatch_arg_t =
+    typename dispatch_arg<typename Callbacks::value_type>::type;
+
+template <typename T>
+concept field_cache_like = requires { typename T::is_field_cache; };
+
+template <typename Callbacks, typename MsgBase>
+constexpr auto with_dispatch_arg(MsgBase const &msg, auto const &f) -> bool {
+    using arg_t = dispatch_arg_t<Callbacks>;
+    if constexpr (field_cache_like<arg_t>) {
+        auto const cache = arg_t{msg};
+        return f(cache);
+    } else {
+        return f(msg);
+    }
+}
+} // namespace msg::detail
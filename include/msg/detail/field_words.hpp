@@ -0,0 +1,177 @@
+#pragma once
+
+#include <msg/field.hpp>
+
+#include <stdx/bit.hpp>
+#include <stdx/ranges.hpp>
+#include <stdx/tuple.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace msg::detail {
+template <typename... BLs>
+auto locator_of(field_locator_t<BLs...> const &) -> field_locator_t<BLs...>;
+
+// A field that lies within one dword of its message: it can be read and
+// written with one shift and mask of that dword.
+template <typename Locator> struct dword_location {
+    constexpr static auto value = false;
+};
+
+template <std::uint32_t Index, std::uint32_t BitSize, std::uint32_t Lsb>
+struct dword_location<field_locator_t<bits_locator_t<Index, BitSize, Lsb>>> {
+    constexpr static auto value = Lsb + BitSize <= 32u;
+    constexpr static auto index = Index;
+    constexpr static auto lsb = Lsb;
+    constexpr static auto mask = stdx::bit_mask<std::uint32_t, BitSize - 1>();
+};
+
+template <typename Field>
+using field_dword_location =
+    dword_location<decltype(locator_of(std::declval<Field>()))>;
+
+// the bits of dword Word that Field occupies (none if it is elsewhere)
+template <typename Field, std::uint32_t Word>
+constexpr auto word_mask = []() -> std::uint32_t {
+    using loc_t = field_dword_location<Field>;
+    if constexpr (loc_t::value) {
+        if constexpr (loc_t::index == Word) {
+            return loc_t::mask << loc_t::lsb;
+        }
+    }
+    return 0;
+}();
+
+/**
+ * Accesses several fields of a message together. When the message is stored
+ * as dwords, the fields that lie within one dword are grouped by dword at
+ * compile time: each dword is loaded (or read, modified and written) once for
+ * all of its fields. Other fields are accessed individually.
+ */
+template <typename... Fields> struct merged_fields {
+    using values_t = stdx::tuple<typename Fields::value_type...>;
+
+  private:
+    // the distinct dwords holding single-dword fields, in order of first use
+    constexpr static auto found = [] {
+        auto ws = std::array<std::uint32_t, sizeof...(Fields)>{};
+        auto n = std::size_t{};
+        auto const add = [&]<typename F>() {
+            using loc_t = field_dword_location<F>;
+            if constexpr (loc_t::value) {
+                auto const end = std::begin(ws) + n;
+                if (std::find(std::begin(ws), end, loc_t::index) == end) {
+                    ws[n++] = loc_t::index;
+                }
+            }
+        };
+        (add.template operator()<Fields>(), ...);
+        return std::pair{ws, n};
+    }();
+
+    constexpr static auto num_words = found.second;
+    constexpr static auto words = [] {
+        auto ws = std::array<std::uint32_t, num_words>{};
+        std::copy_n(std::begin(found.first), num_words, std::begin(ws));
+        return ws;
+    }();
+
+    template <typename Field>
+    constexpr static auto position = static_cast<std::size_t>(
+        std::find(std::begin(words), std::end(words),
+                  field_dword_location<Field>::index) -
+        std::begin(words));
+
+    template <typename R>
+    constexpr static auto merge =
+        std::same_as<typename std::remove_cvref_t<R>::value_type,
+                     std::uint32_t>;
+
+    template <typename Field, typename R>
+    constexpr static auto extract_one(
+        std::array<std::uint32_t, num_words> const &loaded, R const &r) ->
+        typename Field::value_type {
+        using loc_t = field_dword_location<Field>;
+        if constexpr (loc_t::value) {
+            using T = typename Field::value_type;
+            using raw_t = integral_type_for<T>;
+            auto const w = loaded[position<Field>];
+            return stdx::bit_cast<T>(
+                static_cast<raw_t>((w >> loc_t::lsb) & loc_t::mask));
+        } else {
+            return Field::extract(r);
+        }
+    }
+
+    template <typename Field>
+    constexpr static auto word_bits(typename Field::value_type const &value)
+        -> std::uint32_t {
+        using loc_t = field_dword_location<Field>;
+        using raw_t = integral_type_for<typename Field::value_type>;
+        auto const raw =
+            static_cast<std::uint32_t>(stdx::bit_cast<raw_t>(value));
+        return (raw & loc_t::mask) << loc_t::lsb;
+    }
+
+    template <std::uint32_t Word, typename R>
+    constexpr static auto insert_word(
+        R &r, typename Fields::value_type const &...values) -> void {
+        constexpr auto mask = (std::uint32_t{} | ... | word_mask<Fields, Word>);
+        auto const bits_of = [&]<typename F>(auto const &value) {
+            if constexpr (word_mask<F, Word> != 0) {
+                return word_bits<F>(value);
+            } else {
+                return std::uint32_t{};
+            }
+        };
+        auto &w = element<Word>(r);
+        w = (w & ~mask) | (std::uint32_t{} | ... |
+                           bits_of.template operator()<Fields>(values));
+    }
+
+    template <typename Field, typename R>
+    constexpr static auto insert_unmerged(
+        R &r, typename Field::value_type const &value) -> void {
+        if constexpr (not field_dword_location<Field>::value) {
+            Field::insert(r, value);
+        }
+    }
+
+  public:
+    template <stdx::range R>
+    [[nodiscard]] constexpr static auto extract(R const &r) -> values_t {
+        if constexpr (merge<R>) {
+            auto const loaded =
+                [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    return std::array<std::uint32_t, num_words>{
+                        element<words[Is]>(r)...};
+                }(std::make_index_sequence<num_words>{});
+            return values_t{extract_one<Fields>(loaded, r)...};
+        } else {
+            return values_t{Fields::extract(r)...};
+        }
+    }
+
+    template <stdx::range R>
+    constexpr static auto insert(R &&r,
+                                 typename Fields::value_type const &...values)
+        -> void {
+        static_assert((... and is_mutable_value<Fields>),
+                      "Can't change a field with a required value!");
+        if constexpr (merge<R>) {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                (insert_word<words[Is]>(r, values...), ...);
+            }(std::make_index_sequence<num_words>{});
+            (insert_unmerged<Fields>(r, values), ...);
+        } else {
+            (Fields::insert(r, values), ...);
+        }
+    }
+};
+} // namespace msg::detail
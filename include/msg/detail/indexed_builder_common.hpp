@@ -3,11 +3,15 @@
 #include <lookup/entry.hpp>
 #include <lookup/input.hpp>
 #include <lookup/lookup.hpp>
+#include <lookup/pooled_values.hpp>
+#include <lookup/strategies.hpp>
 #include <match/and.hpp>
 #include <match/concepts.hpp>
 #include <match/ops.hpp>
 #include <match/sum_of_products.hpp>
 #include <msg/callback.hpp>
+#include <msg/detail/field_cache.hpp>
+#include <msg/detail/interval_index.hpp>
 #include <msg/detail/separate_sum_terms.hpp>
 #include <msg/field_matchers.hpp>
 
@@ -21,6 +25,9 @@
 #include <stdx/tuple_algorithms.hpp>
 #include <stdx/type_traits.hpp>
 
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+
 #include <algorithm>
 #include <array>
 #include <cstddef>
@@ -62,13 +69,48 @@ constexpr auto remove_match_terms = []<typename C>(C &&c) {
         std::move(new_matcher), std::forward<C>(c).callable};
 };
 
+template <typename... Fields>
+constexpr auto remove_range_match_terms = []<typename C>(C &&c) {
+    using callback_t = std::remove_cvref_t<C>;
+    match::matcher auto new_matcher = remove_range_terms(
+        std::forward<C>(c).matcher, std::type_identity<Fields>{}...);
+    return detail::callback<callback_t::name, typename callback_t::msg_t,
+                            decltype(new_matcher),
+                            typename callback_t::callable_t>{
+        std::move(new_matcher), std::forward<C>(c).callable};
+};
+
+// the terms that the indices on Fields decide: (in)equality terms, and range
+// terms on the fields that get interval indices
+template <typename... Fields>
+constexpr auto remove_indexed_terms = []<typename C>(C &&c) {
+    using range_fields_t =
+        boost::mp11::mp_copy_if<stdx::type_list<Fields...>,
+                                detail::interval_indexable_t>;
+    return [&]<typename... Rs>(stdx::type_list<Rs...>) {
+        return remove_range_match_terms<Rs...>(
+            remove_match_terms<Fields...>(std::forward<C>(c)));
+    }(range_fields_t{});
+};
+
+namespace detail {
+// the narrowest storage for a callback bitset
+template <std::size_t N>
+using callback_set_storage_t =
+    std::conditional_t<N <= 8, std::uint8_t,
+                       std::conditional_t<N <= 16, std::uint16_t,
+                                          std::uint32_t>>;
+} // namespace detail
+
 template <typename FieldType, std::size_t EntryCapacity,
           std::size_t CallbackCapacity>
 struct temp_index {
     using field_type = FieldType;
     using key_type = typename field_type::value_type;
 
-    using value_t = stdx::bitset<CallbackCapacity, std::uint32_t>;
+    using value_t =
+        stdx::bitset<CallbackCapacity,
+                     detail::callback_set_storage_t<CallbackCapacity>>;
     stdx::cx_map<key_type, value_t, EntryCapacity> entries{};
     value_t default_value{};
     value_t negative_value{};
@@ -123,9 +165,168 @@ struct temp_index {
 
 template <typename T> using get_field_type = typename T::field_type;
 
-template <typename... Fields>
-using index_spec = decltype(stdx::make_indexed_tuple<get_field_type>(
-    temp_index<Fields, 512, 256>{}...));
+// Index values are callback bitsets, and many keys share the same bitset
+// (e.g. all keys inherit the positive defaults). Storing each distinct bitset
+// once behind a narrow index is often much smaller; take whichever is.
+using index_lookup_strategy =
+    lookup::best_of<lookup::optimize_for::size, lookup::default_strategies,
+                    lookup::pooled_values<lookup::default_strategies>>;
+
+/// The fields for an indexed_builder to index. The capacities of the indices
+/// are derived from the callbacks when the handler is built.
+template <typename... Fields> struct index_spec {};
+
+/// Use as the IndexSpec of an indexed_builder (or indexed_service) to have
+/// the builder choose (up to MaxIndices) fields to index from the callbacks'
+/// matchers; see detail::select_index_fields.
+template <std::size_t MaxIndices = 3> struct auto_index_spec {};
+
+namespace detail {
+// all the fields of the callbacks' messages
+template <typename Callbacks> struct callback_fields;
+template <typename... Callbacks>
+struct callback_fields<stdx::tuple<Callbacks...>> {
+    using type = boost::mp11::mp_unique<boost::mp11::mp_append<
+        stdx::type_list<>, typename Callbacks::msg_t::fields_t...>>;
+};
+
+// calls f(field, callback index, value) for each term that compares one of
+// Fields with a value
+template <typename Fields>
+CONSTEVAL auto walk_index_keys(auto const &callbacks, auto const &f) -> void {
+    auto idx = std::size_t{};
+    stdx::for_each(
+        [&](auto const &callback) {
+            auto const key = [&]<typename Field>(std::size_t i, auto value) {
+                constexpr auto field =
+                    boost::mp11::mp_find<Fields, Field>::value;
+                if constexpr (field < boost::mp11::mp_size<Fields>::value) {
+                    f(field, i, static_cast<std::uint64_t>(value));
+                }
+            };
+            index_terms(callback.matcher, key, idx);
+            index_not_terms(callback.matcher, key, idx);
+            index_range_terms(
+                callback.matcher,
+                [&]<typename Field>(std::size_t i, auto value, auto) {
+                    key.template operator()<Field>(i, value);
+                },
+                idx);
+            ++idx;
+        },
+        callbacks);
+}
+
+template <typename Fields>
+CONSTEVAL auto count_index_keys(auto const &callbacks) -> std::size_t {
+    auto n = std::size_t{};
+    walk_index_keys<Fields>(callbacks,
+                            [&](std::size_t, std::size_t, std::uint64_t) {
+                                ++n;
+                            });
+    return n;
+}
+
+template <std::size_t NumFields> struct index_field_selection {
+    std::array<std::size_t, NumFields> fields{};
+    std::size_t size{};
+};
+
+// A field is worth indexing if it is constrained by at least two callbacks (a
+// lookup costs about as much as checking one matcher). Fields are ranked by
+// the number of callbacks the index is expected to rule out, assuming that a
+// message's value is equally likely to be any of the keys or none of them: for
+// c constrained callbacks and d keys that is c * d / (d + 1). Ties go to the
+// field with fewer keys (the smaller table).
+template <typename Fields, std::size_t MaxIndices, typename BuilderValue>
+CONSTEVAL auto select_index_fields() {
+    constexpr auto &callbacks = BuilderValue::value.callbacks;
+    constexpr auto num_fields = boost::mp11::mp_size<Fields>::value;
+    constexpr auto num_keys = count_index_keys<Fields>(callbacks);
+
+    std::array<std::size_t, num_fields> constrained{};
+    std::array<std::size_t, num_fields> last_callback{};
+    std::array<std::size_t, num_fields> distinct{};
+    std::array<std::array<std::uint64_t, num_keys>, num_fields> keys{};
+    walk_index_keys<Fields>(
+        callbacks, [&](std::size_t field, std::size_t idx, std::uint64_t k) {
+            if (last_callback[field] != idx + 1) {
+                last_callback[field] = idx + 1;
+                ++constrained[field];
+            }
+            auto const first = std::begin(keys[field]);
+            auto const last =
+                std::next(first, static_cast<std::ptrdiff_t>(distinct[field]));
+            if (std::find(first, last, k) == last) {
+                keys[field][distinct[field]++] = k;
+            }
+        });
+
+    auto const benefit = [&](std::size_t f) {
+        auto const d = static_cast<double>(distinct[f]);
+        return static_cast<double>(constrained[f]) * d / (d + 1);
+    };
+
+    index_field_selection<num_fields> selection{};
+    for (auto f = std::size_t{}; f < num_fields; ++f) {
+        if (constrained[f] >= 2) {
+            selection.fields[selection.size++] = f;
+        }
+    }
+    auto const first = std::begin(selection.fields);
+    std::sort(first,
+              std::next(first, static_cast<std::ptrdiff_t>(selection.size)),
+              [&](auto l, auto r) {
+                  if (benefit(l) != benefit(r)) {
+                      return benefit(l) > benefit(r);
+                  }
+                  if (distinct[l] != distinct[r]) {
+                      return distinct[l] < distinct[r];
+                  }
+                  return l < r;
+              });
+    selection.size = std::min(selection.size, MaxIndices);
+    return selection;
+}
+
+template <typename Fields, auto Selection,
+          typename = std::make_index_sequence<Selection.size>>
+struct selected_index_spec;
+template <typename Fields, auto Selection, std::size_t... Is>
+struct selected_index_spec<Fields, Selection, std::index_sequence<Is...>> {
+    using type =
+        index_spec<boost::mp11::mp_at_c<Fields, Selection.fields[Is]>...>;
+};
+
+// a temp_index has room for every key that the callbacks compare its field
+// with, and a bit for each callback
+template <typename Field, typename BuilderValue>
+constexpr auto index_key_capacity = std::max(
+    count_index_keys<stdx::type_list<Field>>(BuilderValue::value.callbacks),
+    std::size_t{1});
+
+template <typename BuilderValue>
+constexpr auto index_callback_capacity =
+    std::max(BuilderValue::value.callbacks.size(), std::size_t{1});
+
+template <typename IndexSpec, typename BuilderValue> struct resolve_index_spec;
+template <typename... Fields, typename BuilderValue>
+struct resolve_index_spec<index_spec<Fields...>, BuilderValue> {
+    using type = decltype(stdx::make_indexed_tuple<get_field_type>(
+        temp_index<Fields, index_key_capacity<Fields, BuilderValue>,
+                   index_callback_capacity<BuilderValue>>{}...));
+};
+template <std::size_t MaxIndices, typename BuilderValue>
+struct resolve_index_spec<auto_index_spec<MaxIndices>, BuilderValue> {
+    using fields_t = typename callback_fields<
+        std::remove_cvref_t<decltype(BuilderValue::value.callbacks)>>::type;
+    using type = typename resolve_index_spec<
+        typename selected_index_spec<
+            fields_t,
+            select_index_fields<fields_t, MaxIndices, BuilderValue>()>::type,
+        BuilderValue>::type;
+};
+} // namespace detail
 
 template <template <typename, typename, typename, typename...> typename Parent,
           typename IndexSpec, typename Callbacks, typename MsgBase,
@@ -141,22 +342,55 @@ struct indexed_builder_base {
                       ExtraCallbackArgs...>{new_callbacks};
     }
 
-    using callback_func_t = auto (*)(MsgBase const &, ExtraCallbackArgs... args)
-        -> bool;
+    // the temp indices for the fields of IndexSpec (or those chosen for an
+    // auto_index_spec), sized for the callbacks
+    template <typename BuilderValue>
+    using index_spec_t =
+        typename detail::resolve_index_spec<IndexSpec, BuilderValue>::type;
 
+    // callback I with the indexed terms removed from its matcher
     template <typename BuilderValue, std::size_t I>
-    constexpr static auto invoke_callback(MsgBase const &data,
-                                          ExtraCallbackArgs... args) -> bool {
-        constexpr auto cb = IndexSpec{}.apply([&]<typename... Indices>(
-                                                  Indices...) {
-            constexpr auto orig_cb =
-                BuilderValue::value.callbacks[stdx::index<I>];
-            return remove_match_terms<typename Indices::field_type...>(orig_cb);
-        });
+    CONSTEVAL static auto residual_callback() {
+        return index_spec_t<BuilderValue>{}.apply(
+            [&]<typename... Indices>(Indices...) {
+                constexpr auto orig_cb =
+                    BuilderValue::value.callbacks[stdx::index<I>];
+                return remove_indexed_terms<typename Indices::field_type...>(
+                    orig_cb);
+            });
+    }
+
+    template <typename BuilderValue, std::size_t... Is>
+    static auto residual_fields(std::index_sequence<Is...>) ->
+        typename detail::shared_fields<
+            typename decltype(residual_callback<BuilderValue, Is>())::
+                matcher_t...>::type;
+
+    // the callbacks are passed a field_cache over the message when more than
+    // one residual matcher term reads the same field
+    template <typename BuilderValue>
+    using cached_fields_t = decltype(residual_fields<BuilderValue>(
+        std::make_index_sequence<BuilderValue::value.callbacks.size()>{}));
+
+    template <typename BuilderValue>
+    using dispatch_arg_t = std::conditional_t<
+        boost::mp11::mp_empty<cached_fields_t<BuilderValue>>::value, MsgBase,
+        detail::field_cache<MsgBase, cached_fields_t<BuilderValue>>>;
+
+    template <typename BuilderValue>
+    using callback_func_t = auto (*)(dispatch_arg_t<BuilderValue> const &,
+                                     ExtraCallbackArgs... args) -> bool;
+
+    template <typename BuilderValue, std::size_t I>
+    constexpr static auto invoke_callback(
+        dispatch_arg_t<BuilderValue> const &data, ExtraCallbackArgs... args)
+        -> bool {
+        constexpr auto cb = residual_callback<BuilderValue, I>();
 
         auto const &orig_cb = BuilderValue::value.callbacks[stdx::index<I>];
         using CB = std::remove_cvref_t<decltype(cb)>;
-        if constexpr (not validate_matcher<typename CB::matcher_t>()) {
+        using matcher_t = typename CB::matcher_t;
+        if constexpr (not validate_matcher<matcher_t>()) {
             static_assert(
                 stdx::always_false_v<std::remove_cvref_t<decltype(orig_cb)>>,
                 "Indexed callback has matcher that is never matched!");
@@ -165,12 +399,20 @@ struct indexed_builder_base {
         constexpr auto matcher_str =
             stdx::ct_format<" (collapsed by index from [{}])">(
                 orig_cb.matcher.describe());
-        return cb.template handle<matcher_str>(data, args...);
+        if constexpr (std::is_same_v<dispatch_arg_t<BuilderValue>, MsgBase>) {
+            return cb.template handle<matcher_str>(data, args...);
+        } else if constexpr (detail::cacheable_matcher<matcher_t>) {
+            return cb.template handle_matched<matcher_str>(
+                cb.matcher(data), data.message(), args...);
+        } else {
+            return cb.template handle<matcher_str>(data.message(), args...);
+        }
     }
 
     template <typename BuilderValue, std::size_t... Is>
     static CONSTEVAL auto create_callback_array(std::index_sequence<Is...>)
-        -> std::array<callback_func_t, BuilderValue::value.callbacks.size()> {
+        -> std::array<callback_func_t<BuilderValue>,
+                      BuilderValue::value.callbacks.size()> {
         return {invoke_callback<BuilderValue, Is>...};
     }
 
@@ -183,10 +425,11 @@ struct indexed_builder_base {
 
     template <typename BuilderValue>
     static CONSTEVAL auto create_temp_indices() {
-        IndexSpec indices{};
+        using spec_t = index_spec_t<BuilderValue>;
+        spec_t indices{};
         walk_matcher(index_terms, BuilderValue::value.callbacks,
                      [&]<typename Field>(std::size_t idx, auto expected_value) {
-                         if constexpr (stdx::contains_type<IndexSpec, Field>) {
+                         if constexpr (stdx::contains_type<spec_t, Field>) {
                              get<Field>(indices).add_positive(expected_value,
                                                               idx);
                          }
@@ -197,7 +440,7 @@ struct indexed_builder_base {
                        indices);
         walk_matcher(index_not_terms, BuilderValue::value.callbacks,
                      [&]<typename Field>(std::size_t idx, auto expected_value) {
-                         if constexpr (stdx::contains_type<IndexSpec, Field>) {
+                         if constexpr (stdx::contains_type<spec_t, Field>) {
                              get<Field>(indices).add_negative(expected_value,
                                                               idx);
                          }
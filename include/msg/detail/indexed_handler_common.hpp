@@ -1,6 +1,7 @@
 #pragma once
 
-#include <log/log.hpp>
+#include <msg/detail/field_cache.hpp>
+#include <msg/detail/log_unhandled.hpp>
 #include <msg/handler_interface.hpp>
 #include <msg/message.hpp>
 
@@ -8,8 +9,13 @@
 #include <stdx/ranges.hpp>
 #include <stdx/utility.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <iterator>
+#include <optional>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -22,10 +28,43 @@ template <typename Field, typename Lookup> struct index {
         : field_lookup{field_lookup_arg} {}
 
     template <typename Msg> constexpr auto operator()(Msg const &msg) const {
+        return field_lookup[extract(msg)];
+    }
+
+    // ANDs each message's callback candidates into out: the field is extracted
+    // from every message first, then the keys are looked up together (in one
+    // batch, when the lookup supports it). At most batch_chunk_size messages.
+    template <typename Msg, typename V>
+    constexpr auto and_batch(std::span<Msg const> msgs, std::span<V> out) const
+        -> void {
+        using key_t = decltype(extract(std::declval<Msg const &>()));
+        std::array<key_t, detail::batch_chunk_size> keys{};
+        std::array<V, detail::batch_chunk_size> values{};
+
+        auto const n = msgs.size();
+        for (auto i = std::size_t{}; i < n; ++i) {
+            keys[i] = extract(msgs[i]);
+        }
+        auto const ks = std::span<key_t const>{keys}.first(n);
+        auto const vs = std::span<V>{values}.first(n);
+        if constexpr (requires { field_lookup.lookup(ks, vs); }) {
+            field_lookup.lookup(ks, vs);
+        } else {
+            for (auto i = std::size_t{}; i < n; ++i) {
+                vs[i] = field_lookup[ks[i]];
+            }
+        }
+        for (auto i = std::size_t{}; i < n; ++i) {
+            out[i] = out[i] & vs[i];
+        }
+    }
+
+  private:
+    template <typename Msg> constexpr static auto extract(Msg const &msg) {
         if constexpr (stdx::range<Msg>) {
-            return field_lookup[Field::extract(msg)];
+            return Field::extract(msg);
         } else {
-            return field_lookup[Field::extract(std::data(msg))];
+            return Field::extract(std::data(msg));
         }
     }
 };
@@ -52,14 +91,124 @@ struct indexed_handler : handler_interface<MsgBase, ExtraCallbackArgs...> {
         -> bool final {
         auto const callback_candidates = index(msg);
 
-        bool const handled = transform_reduce(
-            [&](auto i) -> bool { return callback_entries[i](msg, args...); },
-            std::logical_or{}, false, callback_candidates);
+        bool const handled = detail::with_dispatch_arg<Callbacks>(
+            msg, [&](auto const &arg) -> bool {
+                return transform_reduce(
+                    [&](auto i) -> bool {
+                        return callback_entries[i](arg, args...);
+                    },
+                    std::logical_or{}, false, callback_candidates);
+            });
 
-        if (not handled) {
-            CIB_ERROR(
-                "None of the registered callbacks ({}) claimed this message.",
-                stdx::ct<stdx::tuple_size_v<Callbacks>>());
+        if (not handled) [[unlikely]] {
+            detail::log_unhandled<stdx::tuple_size_v<Callbacks>>();
+        }
+        return handled;
+    }
+
+    // The indices are looked up for a whole chunk of messages at once; then
+    // each candidate callback runs over the messages it is a candidate for.
+    __attribute__((flatten)) auto handle_batch(std::span<MsgBase const> msgs,
+                                               ExtraCallbackArgs... args) const
+        -> std::size_t final {
+        using candidates_t =
+            decltype(index(std::declval<MsgBase const &>()));
+
+        auto num_handled = std::size_t{};
+        for (auto first = std::size_t{}; first < msgs.size();
+             first += detail::batch_chunk_size) {
+            auto const chunk = msgs.subspan(
+                first, std::min(detail::batch_chunk_size, msgs.size() - first));
+
+            std::array<candidates_t, detail::batch_chunk_size> candidates{};
+            index.lookup_batch(
+                chunk, std::span<candidates_t>{candidates}.first(chunk.size()));
+
+            auto any_candidates = candidates_t{};
+            for (auto i = std::size_t{}; i < chunk.size(); ++i) {
+                any_candidates = any_candidates | candidates[i];
+            }
+
+            std::array<bool, detail::batch_chunk_size> handled{};
+            auto const run_callbacks = [&](auto const &arg_for) {
+                for_each(
+                    [&](auto cb) {
+                        for (auto i = std::size_t{}; i < chunk.size(); ++i) {
+                            if (candidates[i][cb]) {
+                                handled[i] = callback_entries[cb](arg_for(i),
+                                                                  args...) or
+                                             handled[i];
+                            }
+                        }
+                    },
+                    any_candidates);
+            };
+
+            // as in handle, the callbacks considered for a message share one
+            // dispatch arg for it
+            using arg_t = detail::dispatch_arg_t<Callbacks>;
+            if constexpr (detail::field_cache_like<arg_t>) {
+                std::array<std::optional<arg_t>, detail::batch_chunk_size>
+                    caches{};
+                for (auto i = std::size_t{}; i < chunk.size(); ++i) {
+                    caches[i].emplace(chunk[i]);
+                }
+                run_callbacks(
+                    [&](std::size_t i) -> arg_t const & { return *caches[i]; });
+            } else {
+                run_callbacks(
+                    [&](std::size_t i) -> MsgBase const & { return chunk[i]; });
+            }
+
+            for (auto i = std::size_t{}; i < chunk.size(); ++i) {
+                if (handled[i]) [[likely]] {
+                    ++num_handled;
+                } else {
+                    detail::log_unhandled<stdx::tuple_size_v<Callbacks>>();
+                }
+            }
+        }
+        return num_handled;
+    }
+};
+
+// Like indexed_handler, but only the first candidate callback (in order)
+// that matches is called: the candidates are visited lowest bit first, and
+// the rest are skipped once one has handled the message.
+template <typename Index, typename Callbacks, typename MsgBase,
+          typename... ExtraCallbackArgs>
+struct first_match_indexed_handler
+    : handler_interface<MsgBase, ExtraCallbackArgs...> {
+    Index index;
+    Callbacks callback_entries;
+
+    template <typename Idx, typename CBs>
+    constexpr explicit first_match_indexed_handler(Idx &&idx, CBs &&cbs)
+        : index{std::forward<Idx>(idx)},
+          callback_entries{std::forward<CBs>(cbs)} {}
+
+    auto is_match(MsgBase const &msg) const -> bool final {
+        return not index(msg).none();
+    }
+
+    __attribute__((flatten)) auto handle(MsgBase const &msg,
+                                         ExtraCallbackArgs... args) const
+        -> bool final {
+        auto callback_candidates = index(msg);
+        bool const handled = detail::with_dispatch_arg<Callbacks>(
+            msg, [&](auto const &arg) -> bool {
+                while (not callback_candidates.none()) {
+                    // the lowest set bit
+                    auto const i = (~callback_candidates).lowest_unset();
+                    if (callback_entries[i](arg, args...)) {
+                        return true;
+                    }
+                    callback_candidates.reset(i);
+                }
+                return false;
+            });
+        if (not handled) [[unlikely]] {
+            detail::log_unhandled<stdx::tuple_size_v<Callbacks>>();
         }
         return handled;
     }
@@ -72,4 +221,13 @@ constexpr auto make_indexed_handler = []<typename Idx, typename CBs>(
                            MsgBase, ExtraCallbackArgs...>{
         std::forward<Idx>(idx), std::forward<CBs>(cbs)};
 };
+
+template <typename MsgBase, typename... ExtraCallbackArgs>
+constexpr auto make_first_match_indexed_handler =
+    []<typename Idx, typename CBs>(Idx &&idx, CBs &&cbs) {
+        return first_match_indexed_handler<std::remove_cvref_t<Idx>,
+                                           std::remove_cvref_t<CBs>, MsgBase,
+                                           ExtraCallbackArgs...>{
+            std::forward<Idx>(idx), std::forward<CBs>(cbs)};
+    };
 } // namespace msg
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <lookup/entry.hpp>
+#include <lookup/eytzinger_lookup.hpp>
+#include <lookup/input.hpp>
+#include <msg/field_matchers.hpp>
+
+#include <stdx/compiler.hpp>
+#include <stdx/tuple.hpp>
+#include <stdx/tuple_algorithms.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace msg {
+namespace detail {
+// An interval index maps each value of a field to the callbacks whose terms on
+// that field hold for it. The values are split into intervals at the points
+// where that set of callbacks may change; a lookup finds a value's interval
+// with a ranged search over the interval starts.
+
+enum struct rel_op : std::uint8_t { eq, ne, lt, le, gt, ge };
+
+template <typename RelOp> constexpr auto to_rel_op() -> rel_op {
+    if constexpr (std::same_as<RelOp, std::less<>>) {
+        return rel_op::lt;
+    } else if constexpr (std::same_as<RelOp, std::less_equal<>>) {
+        return rel_op::le;
+    } else if constexpr (std::same_as<RelOp, std::greater<>>) {
+        return rel_op::gt;
+    } else {
+        return rel_op::ge;
+    }
+}
+
+template <typename K> struct field_relation {
+    std::size_t callback{};
+    rel_op op{};
+    K value{};
+
+    [[nodiscard]] constexpr auto holds(K k) const -> bool {
+        switch (op) {
+        case rel_op::eq:
+            return k == value;
+        case rel_op::ne:
+            return k != value;
+        case rel_op::lt:
+            return k < value;
+        case rel_op::le:
+            return k <= value;
+        case rel_op::gt:
+            return k > value;
+        case rel_op::ge:
+            return k >= value;
+        }
+        return false;
+    }
+};
+
+// A relation to a value outside the range of K either holds for every key or
+// for none (e.g. k < 300 for a std::uint8_t k holds for every k), so it is
+// made a relation to the lowest key that does the same, rather than to the
+// value truncated to K.
+template <typename K, typename V>
+CONSTEVAL auto make_field_relation(std::size_t callback, rel_op op, V value)
+    -> field_relation<K> {
+    if constexpr (std::integral<V>) {
+        // unary + promotes character types, which the comparisons reject
+        constexpr auto lowest = std::numeric_limits<K>::min();
+        constexpr auto highest = std::numeric_limits<K>::max();
+        auto const above = std::cmp_greater(+value, +highest);
+        if (above or std::cmp_less(+value, +lowest)) {
+            auto const less = op == rel_op::lt or op == rel_op::le;
+            auto const always =
+                op == rel_op::ne or (op != rel_op::eq and above == less);
+            return {callback, always ? rel_op::ge : rel_op::lt, lowest};
+        }
+    }
+    return {callback, op, static_cast<K>(value)};
+}
+
+template <typename Field>
+constexpr auto interval_indexable =
+    std::integral<typename Field::value_type> and
+    not std::same_as<typename Field::value_type, bool>;
+
+template <typename Field>
+using interval_indexable_t = std::bool_constant<interval_indexable<Field>>;
+
+// calls f(relation) for each term of the callbacks that relates Field to a
+// value
+template <typename Field>
+CONSTEVAL auto walk_field_relations(auto const &callbacks, auto const &f)
+    -> void {
+    using key_t = typename Field::value_type;
+    auto idx = std::size_t{};
+    stdx::for_each(
+        [&](auto const &callback) {
+            auto const add = [&]<typename F>(std::size_t i, auto value,
+                                             rel_op op) {
+                if constexpr (std::same_as<F, Field>) {
+                    f(make_field_relation<key_t>(i, op, value));
+                }
+            };
+            index_terms(
+                callback.matcher,
+                [&]<typename F>(std::size_t i, auto value) {
+                    add.template operator()<F>(i, value, rel_op::eq);
+                },
+                idx);
+            index_not_terms(
+                callback.matcher,
+                [&]<typename F>(std::size_t i, auto value) {
+                    add.template operator()<F>(i, value, rel_op::ne);
+                },
+                idx);
+            index_range_terms(
+                callback.matcher,
+                [&]<typename F, typename RelOp>(std::size_t i, auto value,
+                                                RelOp) {
+                    add.template operator()<F>(i, value, to_rel_op<RelOp>());
+                },
+                idx);
+            ++idx;
+        },
+        callbacks);
+}
+
+template <typename Field, typename BuilderValue>
+CONSTEVAL auto count_field_relations() -> std::size_t {
+    auto n = std::size_t{};
+    walk_field_relations<Field>(BuilderValue::value.callbacks,
+                                [&](auto) { ++n; });
+    return n;
+}
+
+// a field gets an interval index (rather than a lookup of its values) when it
+// can be ordered and some callback has a range term on it
+template <typename Field, typename BuilderValue>
+CONSTEVAL auto use_interval_index() -> bool {
+    if constexpr (interval_indexable<Field>) {
+        auto ranges = false;
+        walk_field_relations<Field>(
+            BuilderValue::value.callbacks, [&](auto r) {
+                ranges = ranges or (r.op != rel_op::eq and r.op != rel_op::ne);
+            });
+        return ranges;
+    } else {
+        return false;
+    }
+}
+
+template <typename K, typename V, std::size_t Capacity> struct interval_table {
+    std::array<K, Capacity> starts{};
+    std::array<V, Capacity> values{};
+    std::size_t size{};
+};
+
+// the set of callbacks can only change at the lowest value, at each value in
+// a relation and at the value after it
+template <typename Field, typename BuilderValue>
+CONSTEVAL auto candidate_interval_starts() {
+    using key_t = typename Field::value_type;
+    constexpr auto n = count_field_relations<Field, BuilderValue>();
+
+    interval_table<key_t, bool, 2 * n + 1> t{};
+    t.starts[t.size++] = std::numeric_limits<key_t>::min();
+    walk_field_relations<Field>(BuilderValue::value.callbacks, [&](auto r) {
+        t.starts[t.size++] = r.value;
+        if (r.value != std::numeric_limits<key_t>::max()) {
+            t.starts[t.size++] = static_cast<key_t>(r.value + 1);
+        }
+    });
+
+    auto const first = std::begin(t.starts);
+    auto const last = std::next(first, static_cast<std::ptrdiff_t>(t.size));
+    std::sort(first, last);
+    t.size = static_cast<std::size_t>(
+        std::distance(first, std::unique(first, last)));
+    return t;
+}
+
+template <typename Field, typename Value, typename BuilderValue>
+CONSTEVAL auto build_interval_table() {
+    using key_t = typename Field::value_type;
+    constexpr auto candidates =
+        candidate_interval_starts<Field, BuilderValue>();
+    constexpr auto num_callbacks = BuilderValue::value.callbacks.size();
+
+    interval_table<key_t, Value, candidates.starts.size()> t{};
+    for (auto i = std::size_t{}; i < candidates.size; ++i) {
+        auto const k = candidates.starts[i];
+        // callbacks with no relation on the field match any value
+        Value v{};
+        for (auto c = std::size_t{}; c < num_callbacks; ++c) {
+            v.set(c);
+        }
+        walk_field_relations<Field>(BuilderValue::value.callbacks,
+                                    [&](auto r) {
+                                        if (not r.holds(k)) {
+                                            v.reset(r.callback);
+                                        }
+                                    });
+        // adjacent intervals with the same callbacks are merged
+        if (t.size == 0 or not(t.values[t.size - 1] == v)) {
+            t.starts[t.size] = k;
+            t.values[t.size++] = v;
+        }
+    }
+    return t;
+}
+
+// The interval index is a ranged Eytzinger lookup: the interval starts are
+// the keys, and each looks up the callbacks for the interval it starts.
+template <typename Field, typename Value, typename BuilderValue>
+CONSTEVAL auto make_interval_lookup() {
+    struct {
+        CONSTEVAL auto operator()() const noexcept {
+            constexpr auto t =
+                build_interval_table<Field, Value, BuilderValue>();
+            using entry_t = lookup::entry<typename Field::value_type, Value>;
+            auto entries = std::array<entry_t, t.size>{};
+            for (auto i = std::size_t{}; i < t.size; ++i) {
+                entries[i] = {t.starts[i], t.values[i]};
+            }
+            return lookup::input{t.values[0], entries};
+        }
+        using cx_value_t [[maybe_unused]] = void;
+    } val;
+    return lookup::eytzinger_lookup<true>::make(val);
+}
+} // namespace detail
+} // namespace msg
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <log/log.hpp>
+
+#include <stdx/tuple.hpp>
+#include <stdx/tuple_algorithms.hpp>
+#include <stdx/utility.hpp>
+
+#include <cstddef>
+
+namespace msg {
+// Specialize this to false to log only that a message was unhandled, without
+// describing each callback's mismatch (which also leaves the code for those
+// descriptions out of the binary).
+template <typename...> constexpr inline auto describe_mismatches = true;
+
+namespace detail {
+// Handlers call these (rarely) when no callback claims a message. They are
+// kept out of line so that the dispatch functions stay small.
+
+template <std::size_t NumCallbacks>
+__attribute__((cold, noinline)) auto log_unhandled() -> void {
+    CIB_ERROR("None of the registered callbacks ({}) claimed this message.",
+              stdx::ct<NumCallbacks>());
+}
+
+template <typename Callbacks, typename MsgBase, typename... DummyArgs>
+__attribute__((cold, noinline)) auto
+log_unhandled(Callbacks const &callbacks, MsgBase const &msg) -> void {
+    if constexpr (describe_mismatches<DummyArgs...>) {
+        CIB_ERROR("None of the registered callbacks ({}) claimed this message:",
+                  stdx::ct<stdx::tuple_size_v<Callbacks>>());
+        stdx::for_each([&](auto &callback) { callback.log_mismatch(msg); },
+                       callbacks);
+    } else {
+        log_unhandled<stdx::tuple_size_v<Callbacks>>();
+    }
+}
+} // namespace detail
+} // namespace msg
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace msg {
+// Dispatch policies decide which of the matching callbacks a handler calls.
+
+// every callback that matches is called (the default)
+struct dispatch_all {
+    constexpr static auto first_match = false;
+};
+
+// callbacks are tried in registration order and the first one that matches
+// is the only one called
+struct dispatch_first {
+    constexpr static auto first_match = true;
+};
+
+// as dispatch_first, but callbacks are tried in order of priority (highest
+// first, and then in registration order); see with_priority
+struct dispatch_priority {
+    constexpr static auto first_match = true;
+};
+
+template <int Priority, typename F> struct prioritized {
+    constexpr static auto priority = Priority;
+
+    [[no_unique_address]] F f;
+
+    template <typename... Args>
+    constexpr auto operator()(Args &&...args) const
+        -> decltype(f(std::forward<Args>(args)...)) {
+        return f(std::forward<Args>(args)...);
+    }
+};
+
+/// Gives a callback's callable a priority for dispatch_priority. Callables
+/// without one have priority 0.
+template <int Priority, typename F>
+[[nodiscard]] constexpr auto with_priority(F &&f) {
+    return prioritized<Priority, std::remove_cvref_t<F>>{std::forward<F>(f)};
+}
+
+namespace detail {
+template <typename F> constexpr auto callable_priority = 0;
+template <int Priority, typename F>
+constexpr auto callable_priority<prioritized<Priority, F>> = Priority;
+
+template <typename Callback>
+constexpr auto priority_of =
+    callable_priority<typename Callback::callable_t>;
+} // namespace detail
+} // namespace msg
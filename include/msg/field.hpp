@@ -13,6 +13,7 @@
 #include <stdx/type_traits.hpp>
 
 #include <algorithm>
+#include <bit>
 #include <climits>
 #include <concepts>
 #include <cstdint>
@@ -65,6 +66,50 @@ concept field_locator_for =
     field_extractor_for<T, Spec> and field_inserter_for<T, Spec>;
 
 namespace detail {
+// Element I of a range. A range that can resolve a constant index at compile
+// time (e.g. a buffer_chain with a fixed split) provides at<I>().
+template <auto I, typename R>
+[[nodiscard]] constexpr auto element(R &&r) -> decltype(auto) {
+    if constexpr (requires { std::forward<R>(r).template at<I>(); }) {
+        return std::forward<R>(r).template at<I>();
+    } else {
+        return std::forward<R>(r)[I];
+    }
+}
+
+template <std::unsigned_integral T>
+[[nodiscard]] constexpr auto byteswap(T t) -> T {
+    if constexpr (sizeof(T) == sizeof(std::uint8_t)) {
+        return t;
+    } else if constexpr (sizeof(T) == sizeof(std::uint16_t)) {
+        return __builtin_bswap16(t);
+    } else if constexpr (sizeof(T) == sizeof(std::uint32_t)) {
+        return __builtin_bswap32(t);
+    } else {
+        return __builtin_bswap64(t);
+    }
+}
+
+// In big-endian storage, the bytes of each dword are stored most significant
+// first. A storage element narrower than a dword is then found at a mirrored
+// index within its dword, and an element wider than a byte is byte-swapped
+// (on a little-endian host) as it is loaded or stored.
+template <typename Elem>
+[[nodiscard]] constexpr auto big_endian_index(std::size_t i) -> std::size_t {
+    static_assert(sizeof(Elem) <= sizeof(std::uint32_t),
+                  "Big-endian storage elements cannot be wider than a dword!");
+    return i ^ (sizeof(std::uint32_t) / sizeof(Elem) - 1u);
+}
+
+template <typename Elem>
+[[nodiscard]] constexpr auto big_endian_value(Elem e) -> Elem {
+    if constexpr (std::endian::native == std::endian::little) {
+        return byteswap(e);
+    } else {
+        return e;
+    }
+}
+
 template <stdx::ct_string Name, typename T, std::uint32_t BitSize>
 struct field_spec_t {
     using type = T;
@@ -74,10 +119,35 @@ struct field_spec_t {
     constexpr static auto size = BitSize;
 };
 
-template <std::uint32_t Index, std::uint32_t BitSize, std::uint32_t Lsb>
+template <std::uint32_t Index, std::uint32_t BitSize, std::uint32_t Lsb,
+          bool BigEndian = false>
 struct bits_locator_t {
     constexpr static auto size = BitSize;
 
+    // storage element I, as a host-order value
+    template <auto I, typename R>
+    [[nodiscard]] constexpr static auto load(R &&r) {
+        using elem_t = typename std::remove_cvref_t<R>::value_type;
+        if constexpr (BigEndian) {
+            constexpr auto i = detail::big_endian_index<elem_t>(I);
+            return detail::big_endian_value(
+                static_cast<elem_t>(detail::element<i>(std::forward<R>(r))));
+        } else {
+            return static_cast<elem_t>(detail::element<I>(std::forward<R>(r)));
+        }
+    }
+
+    template <auto I, typename R, typename E>
+    constexpr static auto store(R &&r, E e) -> void {
+        if constexpr (BigEndian) {
+            constexpr auto i = detail::big_endian_index<E>(I);
+            detail::element<i>(std::forward<R>(r)) =
+                detail::big_endian_value(e);
+        } else {
+            detail::element<I>(std::forward<R>(r)) = e;
+        }
+    }
+
     template <std::unsigned_integral T>
     [[nodiscard]] constexpr static auto fold(T value) -> T {
         if constexpr (BitSize == stdx::bit_size<T>()) {
@@ -117,22 +187,24 @@ struct bits_locator_t {
                 constexpr auto mask =
                     stdx::bit_mask<T, CurrentMsb % elem_size>();
                 constexpr auto shift = Lsb % elem_size;
-                return (std::forward<Rng>(rng)[current_idx] & mask) >> shift;
+                auto const elem = load<current_idx>(std::forward<Rng>(rng));
+                return (elem & mask) >> shift;
             } else if constexpr (current_idx == min_idx) {
                 constexpr auto shift = Lsb % elem_size;
                 value <<= (elem_size - shift);
-                return value | (std::forward<Rng>(rng)[current_idx] >> shift);
+                auto const elem = load<current_idx>(std::forward<Rng>(rng));
+                return value | (elem >> shift);
             } else if constexpr (current_idx == max_idx) {
                 constexpr auto mask =
                     stdx::bit_mask<T, CurrentMsb % elem_size>();
                 constexpr auto NewMsb =
                     (CurrentMsb / elem_size * elem_size) - 1u;
+                auto const elem = load<current_idx>(std::forward<Rng>(rng));
                 MUSTTAIL return recurse.template operator()<NewMsb>(
-                    recurse, std::forward<Rng>(rng),
-                    std::forward<Rng>(rng)[current_idx] & mask);
+                    recurse, std::forward<Rng>(rng), elem & mask);
             } else {
                 value <<= elem_size;
-                value |= std::forward<Rng>(rng)[current_idx];
+                value |= load<current_idx>(std::forward<Rng>(rng));
                 constexpr auto NewMsb = CurrentMsb - elem_size;
                 MUSTTAIL return recurse.template operator()<NewMsb>(
                     recurse, std::forward<Rng>(rng), value);
@@ -166,9 +238,10 @@ struct bits_locator_t {
                 constexpr auto leftover_mask =
                     ~stdx::bit_mask<elem_t, msb, lsb>();
 
-                auto &elem = std::forward<Rng>(rng)[current_idx];
+                auto elem = load<current_idx>(std::forward<Rng>(rng));
                 elem &= leftover_mask;
                 elem |= static_cast<elem_t>(value << lsb);
+                store<current_idx>(std::forward<Rng>(rng), elem);
             } else if constexpr (current_idx == min_idx) {
                 constexpr auto lsb = CurrentLsb % elem_size;
                 constexpr auto numbits = elem_size - lsb;
@@ -176,9 +249,10 @@ struct bits_locator_t {
                     stdx::bit_mask<elem_t, numbits - 1>();
                 constexpr auto leftover_mask = ~(value_mask << lsb);
 
-                auto &elem = std::forward<Rng>(rng)[current_idx];
+                auto elem = load<current_idx>(std::forward<Rng>(rng));
                 elem &= leftover_mask;
                 elem |= static_cast<elem_t>((value & value_mask) << lsb);
+                store<current_idx>(std::forward<Rng>(rng), elem);
 
                 constexpr auto NewLsb = CurrentLsb + numbits;
                 MUSTTAIL return recurse.template operator()<NewLsb>(
@@ -186,8 +260,8 @@ struct bits_locator_t {
             } else {
                 constexpr auto value_mask = stdx::bit_mask<elem_t>();
 
-                auto &elem = std::forward<Rng>(rng)[current_idx];
-                elem = value & value_mask;
+                store<current_idx>(std::forward<Rng>(rng),
+                                   static_cast<elem_t>(value & value_mask));
 
                 constexpr auto NewLsb = CurrentLsb + elem_size;
                 MUSTTAIL return recurse.template operator()<NewLsb>(
@@ -310,6 +384,7 @@ constexpr auto unit_bit_size(T t) -> std::uint32_t {
 struct at {
     msb_t msb_{};
     lsb_t lsb_{};
+    bool big_endian_{};
 
     constexpr at() = default;
     constexpr at(msb_t m, lsb_t l) : msb_{m}, lsb_{l} {}
@@ -343,15 +418,26 @@ struct at {
         return stdx::to_underlying(lsb_);
     }
     [[nodiscard]] constexpr auto shifted_by(auto n) const -> at {
-        return {msb_t{stdx::to_underlying(msb_) + n},
-                lsb_t{stdx::to_underlying(lsb_) + n}};
+        auto a = at{msb_t{stdx::to_underlying(msb_) + n},
+                    lsb_t{stdx::to_underlying(lsb_) + n}};
+        a.big_endian_ = big_endian_;
+        return a;
+    }
+    [[nodiscard]] constexpr auto big_endian() const -> bool {
+        return big_endian_;
+    }
+    [[nodiscard]] constexpr auto as_big_endian() const -> at {
+        auto a = *this;
+        a.big_endian_ = true;
+        return a;
     }
 };
 
 namespace detail {
 template <at... Ats>
 using locator_for =
-    field_locator_t<bits_locator_t<Ats.index(), Ats.size(), Ats.lsb()>...>;
+    field_locator_t<bits_locator_t<Ats.index(), Ats.size(), Ats.lsb(),
+                                   Ats.big_endian()>...>;
 
 template <at... Ats> constexpr inline auto field_size = (0u + ... + Ats.size());
 
@@ -389,6 +475,29 @@ concept compatible_with_default = D::template is_compatible_value<V>;
 template <stdx::ct_string Name, typename T = std::uint32_t, auto... Ats>
 struct field_id_t {};
 
+// a field's matcher, referring instead to the big-endian versions of fields
+template <typename M> struct big_endian_matcher {
+    using type = M;
+};
+template <typename M>
+using big_endian_matcher_t = typename big_endian_matcher<M>::type;
+
+template <typename RelOp, typename Field, typename Field::type X>
+struct big_endian_matcher<rel_matcher_t<RelOp, Field, X>> {
+    using type = rel_matcher_t<RelOp, typename Field::big_endian_t, X>;
+};
+template <typename M> struct big_endian_matcher<match::not_t<M>> {
+    using type = match::not_t<big_endian_matcher_t<M>>;
+};
+template <typename L, typename R>
+struct big_endian_matcher<match::and_t<L, R>> {
+    using type =
+        match::and_t<big_endian_matcher_t<L>, big_endian_matcher_t<R>>;
+};
+template <typename L, typename R> struct big_endian_matcher<match::or_t<L, R>> {
+    using type = match::or_t<big_endian_matcher_t<L>, big_endian_matcher_t<R>>;
+};
+
 template <at... Ats> struct sort_key_t {
     constexpr static auto sort_key = std::min({Ats.sort_key()...});
 };
@@ -519,6 +628,11 @@ class field_t : public field_spec_t<Name, T, detail::field_size<Ats...>>,
     template <at... NewAts>
     using located = field_t<Name, T, Default, M, NewAts...>;
 
+    // ======================================================================
+    // the same field in big-endian storage
+    using big_endian_t = field_t<Name, T, Default, big_endian_matcher_t<M>,
+                                 Ats.as_big_endian()...>;
+
     constexpr static auto bitsize = sizeof(T) * CHAR_BIT;
     using default_located = located<at{msb_t{bitsize - 1}, lsb_t{}}>;
 
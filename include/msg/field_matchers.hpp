@@ -97,6 +97,58 @@ constexpr inline class remove_terms_t {
     }
 } remove_terms{};
 
+// Visits the terms that order a field against a value (<, <=, >, >=): these
+// can be indexed with intervals.
+constexpr inline class index_range_terms_t {
+    template <match::matcher M>
+    friend constexpr auto tag_invoke(index_range_terms_t, M const &m,
+                                     stdx::callable auto const &f,
+                                     std::size_t idx) -> void {
+        if constexpr (stdx::is_specialization_of_v<M, match::or_t> or
+                      stdx::is_specialization_of_v<M, match::and_t>) {
+            tag_invoke(index_range_terms_t{}, m.lhs, f, idx);
+            tag_invoke(index_range_terms_t{}, m.rhs, f, idx);
+        }
+    }
+
+  public:
+    template <typename... Ts>
+    constexpr auto operator()(Ts &&...ts) const
+        noexcept(noexcept(tag_invoke(std::declval<index_range_terms_t>(),
+                                     std::forward<Ts>(ts)...)))
+            -> decltype(tag_invoke(*this, std::forward<Ts>(ts)...)) {
+        return tag_invoke(*this, std::forward<Ts>(ts)...);
+    }
+} index_range_terms{};
+
+constexpr inline class remove_range_terms_t {
+    template <match::matcher M, typename... Fields>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(remove_range_terms_t, M const &m,
+               [[maybe_unused]] Fields... fs) -> match::matcher auto {
+        if constexpr (stdx::is_specialization_of_v<M, match::or_t>) {
+            return tag_invoke(remove_range_terms_t{}, m.lhs, fs...) or
+                   tag_invoke(remove_range_terms_t{}, m.rhs, fs...);
+        } else if constexpr (stdx::is_specialization_of_v<M, match::and_t>) {
+            return tag_invoke(remove_range_terms_t{}, m.lhs, fs...) and
+                   tag_invoke(remove_range_terms_t{}, m.rhs, fs...);
+        } else {
+            // unlike remove_terms, a not term stays: index_range_terms
+            // doesn't visit inside it
+            return m;
+        }
+    }
+
+  public:
+    template <typename... Ts>
+    constexpr auto operator()(Ts &&...ts) const
+        noexcept(noexcept(tag_invoke(std::declval<remove_range_terms_t>(),
+                                     std::forward<Ts>(ts)...)))
+            -> decltype(tag_invoke(*this, std::forward<Ts>(ts)...)) {
+        return tag_invoke(*this, std::forward<Ts>(ts)...);
+    }
+} remove_range_terms{};
+
 namespace detail {
 template <typename RelOp> constexpr auto inverse_op() {
     if constexpr (std::same_as<RelOp, std::less<>>) {
@@ -114,6 +166,12 @@ template <typename RelOp> constexpr auto inverse_op() {
     }
 }
 
+template <typename RelOp>
+concept ordering_op = std::same_as<RelOp, std::less<>> or
+                      std::same_as<RelOp, std::less_equal<>> or
+                      std::same_as<RelOp, std::greater<>> or
+                      std::same_as<RelOp, std::greater_equal<>>;
+
 template <typename RelOp> constexpr auto to_string() {
     using namespace stdx::literals;
     if constexpr (std::same_as<RelOp, std::less<>>) {
@@ -183,7 +241,9 @@ struct rel_matcher_t {
 
     template <typename Msg>
     [[nodiscard]] constexpr static auto extract_field(Msg const &msg) {
-        if constexpr (stdx::range<Msg>) {
+        if constexpr (requires { typename Msg::is_field_cache; }) {
+            return msg.template get<Field>();
+        } else if constexpr (stdx::range<Msg>) {
             return Field::extract(msg);
         } else {
             return Field::extract(std::data(msg));
@@ -215,6 +275,27 @@ template <typename Field, auto ExpectedValue>
 constexpr auto greater_than_or_equal_to =
     greater_than_or_equal_to_t<Field, ExpectedValue>{};
 
+template <detail::ordering_op RelOp, typename Field, auto X>
+constexpr auto tag_invoke(index_range_terms_t,
+                          rel_matcher_t<RelOp, Field, X> const &,
+                          stdx::callable auto const &f, std::size_t idx)
+    -> void {
+    f.template operator()<Field>(idx, X, RelOp{});
+}
+
+template <detail::ordering_op RelOp, typename Field, auto X,
+          typename... Fields>
+[[nodiscard]] constexpr auto tag_invoke(remove_range_terms_t,
+                                        rel_matcher_t<RelOp, Field, X> const &m,
+                                        std::type_identity<Fields>...)
+    -> match::matcher auto {
+    if constexpr ((std::is_same_v<Field, Fields> or ...)) {
+        return match::always;
+    } else {
+        return m;
+    }
+}
+
 template <typename Field, auto X, decltype(X) Y>
 [[nodiscard]] constexpr auto
 tag_invoke(match::implies_t, less_than_or_equal_to_t<Field, X> const &,
@@ -1,11 +1,16 @@
 #pragma once
 
-#include <log/log.hpp>
+#include <msg/detail/log_unhandled.hpp>
 #include <msg/handler_interface.hpp>
 
 #include <stdx/tuple_algorithms.hpp>
 #include <stdx/utility.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+
 namespace msg {
 
 template <typename Callbacks, typename MsgBase, typename... ExtraCallbackArgs>
@@ -27,12 +32,66 @@ struct handler : handler_interface<MsgBase, ExtraCallbackArgs...> {
                 return (0u | ... | cbs.handle(msg, args...));
             },
             callbacks);
-        if (!found_valid_callback) {
-            CIB_ERROR(
-                "None of the registered callbacks ({}) claimed this message:",
-                stdx::ct<stdx::tuple_size_v<Callbacks>>());
-            stdx::for_each([&](auto &callback) { callback.log_mismatch(msg); },
-                           callbacks);
+        if (!found_valid_callback) [[unlikely]] {
+            detail::log_unhandled(callbacks, msg);
+        }
+        return found_valid_callback;
+    }
+
+    // each callback runs over a chunk of messages before the next one does
+    auto handle_batch(std::span<MsgBase const> msgs,
+                      ExtraCallbackArgs... args) const -> std::size_t final {
+        auto num_handled = std::size_t{};
+        for (auto first = std::size_t{}; first < msgs.size();
+             first += detail::batch_chunk_size) {
+            auto const chunk = msgs.subspan(
+                first, std::min(detail::batch_chunk_size, msgs.size() - first));
+
+            std::array<bool, detail::batch_chunk_size> handled{};
+            stdx::for_each(
+                [&](auto &callback) {
+                    for (auto i = std::size_t{}; i < chunk.size(); ++i) {
+                        handled[i] =
+                            callback.handle(chunk[i], args...) or handled[i];
+                    }
+                },
+                callbacks);
+
+            for (auto i = std::size_t{}; i < chunk.size(); ++i) {
+                if (handled[i]) [[likely]] {
+                    ++num_handled;
+                } else {
+                    detail::log_unhandled(callbacks, chunk[i]);
+                }
+            }
+        }
+        return num_handled;
+    }
+};
+
+// Like handler, but stops at the first callback (in order) that matches:
+// that is the only callback called.
+template <typename Callbacks, typename MsgBase, typename... ExtraCallbackArgs>
+struct first_match_handler : handler_interface<MsgBase, ExtraCallbackArgs...> {
+    Callbacks callbacks{};
+
+    constexpr explicit first_match_handler(Callbacks new_callbacks)
+        : callbacks{new_callbacks} {}
+
+    auto is_match(MsgBase const &msg) const -> bool final {
+        return stdx::any_of(
+            [&](auto &callback) { return callback.is_match(msg); }, callbacks);
+    }
+
+    auto handle(MsgBase const &msg, ExtraCallbackArgs... args) const
+        -> bool final {
+        auto const found_valid_callback = stdx::apply(
+            [&](auto &...cbs) -> bool {
+                return (false or ... or cbs.handle(msg, args...));
+            },
+            callbacks);
+        if (!found_valid_callback) [[unlikely]] {
+            detail::log_unhandled(callbacks, msg);
         }
         return found_valid_callback;
     }
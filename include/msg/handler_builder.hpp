@@ -1,5 +1,6 @@
 #pragma once
 
+#include <msg/dispatch_policy.hpp>
 #include <msg/handler.hpp>
 
 #include <stdx/tuple.hpp>
@@ -18,9 +19,16 @@ struct handler_builder {
             new_callbacks};
     }
 
-    template <typename BuilderValue> constexpr static auto build() {
-        return handler<Callbacks, MsgBase, ExtraCallbackArgs...>{
-            BuilderValue::value.callbacks};
+    template <typename BuilderValue, typename Policy = dispatch_all>
+    constexpr static auto build() {
+        if constexpr (Policy::first_match) {
+            return first_match_handler<Callbacks, MsgBase,
+                                       ExtraCallbackArgs...>{
+                BuilderValue::value.callbacks};
+        } else {
+            return handler<Callbacks, MsgBase, ExtraCallbackArgs...>{
+                BuilderValue::value.callbacks};
+        }
     }
 };
 
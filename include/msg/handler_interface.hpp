@@ -6,13 +6,38 @@
 #include <stdx/panic.hpp>
 #include <stdx/type_traits.hpp>
 
+#include <cstddef>
+#include <span>
+
 namespace msg {
+namespace detail {
+// handlers that override handle_batch work through a batch in chunks of (at
+// most) this many messages
+constexpr inline auto batch_chunk_size = std::size_t{64};
+} // namespace detail
+
 template <typename MsgBase, typename... ExtraCallbackArgs>
 struct handler_interface {
     virtual auto is_match(MsgBase const &msg) const -> bool = 0;
 
     virtual auto handle(MsgBase const &msg,
                         ExtraCallbackArgs... extra_args) const -> bool = 0;
+
+    /// Handles a burst of messages, returning how many of them were claimed
+    /// by a callback. By default each message is handled in turn; a handler
+    /// may instead run each callback over all the messages it matches, so
+    /// the order in which callbacks see the messages is unspecified.
+    virtual auto handle_batch(std::span<MsgBase const> msgs,
+                              ExtraCallbackArgs... extra_args) const
+        -> std::size_t {
+        auto handled = std::size_t{};
+        for (auto const &msg : msgs) {
+            if (handle(msg, extra_args...)) {
+                ++handled;
+            }
+        }
+        return handled;
+    }
 };
 
 namespace detail {
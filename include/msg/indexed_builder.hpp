@@ -2,6 +2,8 @@
 
 #include <log/log.hpp>
 #include <msg/detail/indexed_builder_common.hpp>
+#include <msg/dispatch_policy.hpp>
+#include <msg/handler.hpp>
 #include <msg/indexed_handler.hpp>
 
 #include <stdx/bitset.hpp>
@@ -16,7 +18,8 @@
 #include <type_traits>
 
 namespace msg {
-// TODO: needs index configuration
+// IndexSpec is an index_spec naming the fields to index, or an
+// auto_index_spec to have the builder choose them
 template <typename IndexSpec, typename Callbacks, typename MsgBase,
           typename... ExtraCallbackArgs>
 struct indexed_builder
@@ -36,7 +39,7 @@ struct indexed_builder
     static CONSTEVAL auto make_input() {
         struct {
             CONSTEVAL auto operator()() const noexcept {
-                constexpr IndexSpec indices =
+                constexpr auto indices =
                     base_t::template create_temp_indices<BuilderValue>();
                 using key_type =
                     typename decltype(get<I>(indices).entries)::key_type;
@@ -50,25 +53,57 @@ struct indexed_builder
         } val;
         return val;
     }
-    template <typename BuilderValue> static CONSTEVAL auto build() {
+    template <typename BuilderValue, typename Policy = dispatch_all>
+    static CONSTEVAL auto build() {
+        using spec_t = typename base_t::template index_spec_t<BuilderValue>;
+        if constexpr (stdx::tuple_size_v<spec_t> == 0) {
+            // nothing worth indexing: match each callback in turn
+            if constexpr (Policy::first_match) {
+                return first_match_handler<Callbacks, MsgBase,
+                                           ExtraCallbackArgs...>{
+                    BuilderValue::value.callbacks};
+            } else {
+                return handler<Callbacks, MsgBase, ExtraCallbackArgs...>{
+                    BuilderValue::value.callbacks};
+            }
+        } else {
+            return build_indexed<BuilderValue, Policy>();
+        }
+    }
+
+  private:
+    template <typename BuilderValue, typename Policy>
+    static CONSTEVAL auto build_indexed() {
         constexpr auto make_index_lookup =
             []<typename I, std::size_t... Es>(std::index_sequence<Es...>) {
-                return lookup::make(make_input<BuilderValue, I, Es...>());
+                return index_lookup_strategy::make(
+                    make_input<BuilderValue, I, Es...>());
             };
 
-        constexpr IndexSpec temp_indices =
+        constexpr auto temp_indices =
             base_t::template create_temp_indices<BuilderValue>();
         auto const entry_index_seq = [&]<typename I>() {
             return std::make_index_sequence<
                 get<I>(temp_indices).entries.size()>{};
         };
 
+        // a field with range terms on it gets an interval index
+        auto const make_field_lookup = [&]<typename I>() {
+            using field_t = typename I::field_type;
+            if constexpr (detail::use_interval_index<field_t, BuilderValue>()) {
+                return detail::make_interval_lookup<
+                    field_t, typename I::value_t, BuilderValue>();
+            } else {
+                return make_index_lookup.template operator()<I>(
+                    entry_index_seq.template operator()<I>());
+            }
+        };
+
         constexpr auto baked_indices =
             temp_indices.apply([&]<typename... I>(I...) {
                 return indices {
                     index{typename I::field_type{},
-                          make_index_lookup.template operator()<I>(
-                              entry_index_seq.template operator()<I>())}...
+                          make_field_lookup.template operator()<I>()}...
                 };
             });
 
@@ -77,8 +112,14 @@ struct indexed_builder
             base_t::template create_callback_array<BuilderValue>(
                 std::make_index_sequence<num_callbacks>{});
 
-        return make_indexed_handler<MsgBase, ExtraCallbackArgs...>(
-            baked_indices, callback_array);
+        if constexpr (Policy::first_match) {
+            return make_first_match_indexed_handler<MsgBase,
+                                                    ExtraCallbackArgs...>(
+                baked_indices, callback_array);
+        } else {
+            return make_indexed_handler<MsgBase, ExtraCallbackArgs...>(
+                baked_indices, callback_array);
+        }
     }
 };
 
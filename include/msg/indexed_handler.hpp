@@ -4,6 +4,10 @@
 
 #include <stdx/compiler.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <span>
+
 namespace msg {
 
 template <typename... Indices> struct indices : Indices... {
@@ -13,6 +17,14 @@ template <typename... Indices> struct indices : Indices... {
     constexpr auto operator()(auto const &data) const {
         return (this->Indices::operator()(data) & ...);
     }
+
+    // out[i] = (*this)(msgs[i]), for at most batch_chunk_size messages
+    template <typename Msg, typename V>
+    constexpr auto lookup_batch(std::span<Msg const> msgs,
+                                std::span<V> out) const -> void {
+        std::fill(std::begin(out), std::end(out), ~V{});
+        (this->Indices::and_batch(msgs, out), ...);
+    }
 };
 
 } // namespace msg
@@ -2,6 +2,7 @@
 
 #include <match/ops.hpp>
 #include <match/sum_of_products.hpp>
+#include <msg/detail/field_words.hpp>
 #include <msg/field.hpp>
 #include <msg/field_matchers.hpp>
 
@@ -23,12 +24,30 @@
 #include <boost/mp11/set.hpp>
 
 #include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <functional>
 #include <iterator>
 #include <type_traits>
+#include <utility>
 
 namespace msg {
+// The byte order of a message's storage, given by its environment. Storage is
+// little-endian (dwords in host order) unless the environment says otherwise.
+[[maybe_unused]] constexpr inline struct get_byte_order_t {
+    template <typename T>
+        requires true // more constrained
+    CONSTEVAL auto operator()(T &&t) const noexcept(
+        noexcept(std::forward<T>(t).query(std::declval<get_byte_order_t>())))
+        -> decltype(std::forward<T>(t).query(*this)) {
+        return std::forward<T>(t).query(*this);
+    }
+
+    CONSTEVAL auto operator()(auto &&) const { return std::endian::little; }
+} get_byte_order;
+
+using big_endian = stdx::make_env_t<get_byte_order, std::endian::big>;
+
 template <auto V> struct constant_t {};
 template <auto V> constexpr static auto constant = constant_t<V>{};
 
@@ -231,6 +250,16 @@ template <stdx::ct_string Name, typename... Fields> class msg_access {
         return Field::extract(std::forward<R>(r));
     }
 
+    template <typename N>
+    using field_for =
+        std::remove_cvref_t<decltype(stdx::get<N>(FieldsTuple{}))>;
+
+    template <typename... Ns, stdx::range R>
+    constexpr static auto get_merged(R &&r) {
+        (check<field_for<Ns>, std::remove_cvref_t<R>>(), ...);
+        return merged_fields<field_for<Ns>...>::extract(r);
+    }
+
   public:
     template <stdx::range R, stdx::ct_string... Ns>
     constexpr static auto set(R &&r, field_name<Ns>...) -> void {
@@ -239,7 +268,16 @@ template <stdx::ct_string Name, typename... Fields> class msg_access {
 
     template <stdx::range R, some_field_value... Vs>
     constexpr static auto set(R &&r, Vs... vs) -> void {
-        (set1(r, vs), ...);
+        using names_t = boost::mp11::mp_list<name_for<Vs>...>;
+        if constexpr (boost::mp11::mp_is_set<names_t>::value) {
+            // one read-modify-write per dword for all the fields in it
+            (check<field_for<name_for<Vs>>, std::remove_cvref_t<R>>(), ...);
+            merged_fields<field_for<name_for<Vs>>...>::insert(
+                r, static_cast<typename field_for<name_for<Vs>>::value_type>(
+                       vs.value)...);
+        } else {
+            (set1(r, vs), ...);
+        }
     }
 
     template <stdx::range R, typename... Fs>
@@ -256,12 +294,22 @@ template <stdx::ct_string Name, typename... Fields> class msg_access {
         return get<name_for<F>>(std::forward<R>(r));
     }
 
+    // several fields at once, as a tuple: each dword is loaded only once
+    template <stdx::range R, typename F, typename G, typename... Fs>
+    constexpr static auto get(R &&r, F, G, Fs...) {
+        return get_merged<name_for<F>, name_for<G>, name_for<Fs>...>(
+            std::forward<R>(r));
+    }
+
     template <stdx::range R>
     [[nodiscard]] constexpr static auto describe(R &&r) {
         using namespace stdx::literals;
         auto const descs = [&] {
             auto const field_descriptions =
-                stdx::tuple{Fields::describe(Fields::extract(r))...};
+                merged_fields<Fields...>::extract(r).apply(
+                    [](auto const &...vs) {
+                        return stdx::tuple{Fields::describe(vs)...};
+                    });
             if constexpr (sizeof...(Fields) > 0) {
                 return field_descriptions.join(
                     [](auto lhs, auto rhs) { return lhs + ", "_ctst + rhs; });
@@ -290,6 +338,11 @@ concept storage_like = stdx::range<T> and requires {
     typename T::value_type;
 };
 
+// storage (like a buffer_chain) that views hold as it is, not through a span
+template <typename T>
+concept chained_storage =
+    storage_like<T> and requires { typename T::is_chained_storage; };
+
 template <stdx::ct_string Name, typename Env, typename... Fields>
 struct message;
 
@@ -308,10 +361,22 @@ using unique_by_name = boost::mp11::mp_unique_if<
     boost::mp11::mp_sort<boost::mp11::mp_list<Fields...>, field_sort_fn>,
     name_equal_fn>;
 
+// the fields of a message as stored in its byte order
+template <std::endian> struct stored_q {
+    template <typename Field> using fn = Field;
+};
+template <> struct stored_q<std::endian::big> {
+    template <typename Field> using fn = typename Field::big_endian_t;
+};
+
+template <typename Env, typename Field>
+using stored_field_t =
+    typename stored_q<get_byte_order(Env{})>::template fn<Field>;
+
 template <stdx::ct_string Name, typename Env, typename... Fields>
-using message_without_unique_field_names =
-    boost::mp11::mp_apply_q<detail::msg_q<Name, Env>,
-                            detail::unique_by_name<Fields...>>;
+using message_without_unique_field_names = boost::mp11::mp_apply_q<
+    detail::msg_q<Name, Env>,
+    detail::unique_by_name<stored_field_t<Env, Fields>...>>;
 
 template <stdx::ct_string Name, typename... Fields>
 struct message_with_unique_field_names {
@@ -343,6 +408,9 @@ template <stdx::ct_string Name, typename Access, typename T> struct msg_base {
     [[nodiscard]] constexpr auto get(auto f) const {
         return Access::get(as_derived().data(), f);
     }
+    [[nodiscard]] constexpr auto get(auto f, auto g, auto... fs) const {
+        return Access::get(as_derived().data(), f, g, fs...);
+    }
     constexpr auto set(auto... fs) -> void {
         Access::set(as_derived().data(), fs...);
     }
@@ -573,6 +641,9 @@ struct message {
     view_t(S &)
         -> view_t<stdx::span<typename S::value_type, stdx::ct_capacity_v<S>>>;
 
+    template <detail::chained_storage S> view_t(S const &) -> view_t<S>;
+    template <detail::chained_storage S> view_t(S &) -> view_t<S>;
+
     template <typename T, std::size_t N>
         requires(std::is_const_v<T>)
     view_t(stdx::span<T, N>) -> view_t<stdx::span<T, N>>;
@@ -597,7 +668,9 @@ struct message {
                                            Fields...>;
 
     template <stdx::envlike E>
-    using with_env = message<Name, stdx::append_env_t<Env, E>, Fields...>;
+    using with_env =
+        message_without_unique_field_names<Name, stdx::append_env_t<Env, E>,
+                                           Fields...>;
 };
 } // namespace detail
 
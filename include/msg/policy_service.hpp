@@ -0,0 +1,134 @@
+#pragma once
+
+#include <msg/decision_tree_builder.hpp>
+#include <msg/dispatch_policy.hpp>
+#include <msg/handler_builder.hpp>
+#include <msg/handler_interface.hpp>
+#include <msg/indexed_builder.hpp>
+
+#include <stdx/compiler.hpp>
+#include <stdx/tuple.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+namespace msg {
+/**
+ * Wraps a handler builder (handler_builder, indexed_builder or
+ * decision_tree_builder) so that the handler it builds follows a dispatch
+ * policy.
+ *
+ * For dispatch_priority the callbacks are reordered by priority at compile
+ * time, so that "first match" in the built handler is the highest priority
+ * match. EmptyBuilder is the wrapped builder with no callbacks, which the
+ * reordered callbacks are added to.
+ */
+template <typename Policy, typename EmptyBuilder,
+          typename Builder = EmptyBuilder>
+struct policy_builder {
+    Builder builder{};
+
+    template <typename... Ts> [[nodiscard]] constexpr auto add(Ts... ts) {
+        auto new_builder = builder.add(ts...);
+        return policy_builder<Policy, EmptyBuilder, decltype(new_builder)>{
+            new_builder};
+    }
+
+    template <typename BuilderValue> CONSTEVAL static auto build() {
+        using inner_builder_t =
+            std::remove_cvref_t<decltype(inner_value<BuilderValue>::value)>;
+        return inner_builder_t::template build<inner_value<BuilderValue>,
+                                               Policy>();
+    }
+
+  private:
+    // highest priority first, then in registration order
+    template <typename BuilderValue> CONSTEVAL static auto priority_order() {
+        constexpr auto &callbacks = BuilderValue::value.builder.callbacks;
+        constexpr auto n = stdx::tuple_size_v<
+            std::remove_cvref_t<decltype(callbacks)>>;
+        auto const priorities = callbacks.apply([](auto const &...cbs) {
+            return std::array<int, n>{
+                detail::priority_of<std::remove_cvref_t<decltype(cbs)>>...};
+        });
+
+        std::array<std::size_t, n> order{};
+        std::iota(std::begin(order), std::end(order), std::size_t{});
+        std::sort(std::begin(order), std::end(order), [&](auto l, auto r) {
+            if (priorities[l] != priorities[r]) {
+                return priorities[l] > priorities[r];
+            }
+            return l < r;
+        });
+        return order;
+    }
+
+    template <typename BuilderValue> struct inner_value {
+        constexpr static auto value = [] {
+            constexpr auto &b = BuilderValue::value.builder;
+            if constexpr (std::is_same_v<Policy, dispatch_priority>) {
+                constexpr auto order = priority_order<BuilderValue>();
+                return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    return EmptyBuilder{}.add(
+                        b.callbacks[stdx::index<order[Is]>]...);
+                }(std::make_index_sequence<order.size()>{});
+            } else {
+                return b;
+            }
+        }();
+    };
+};
+
+// Like service, but the handler follows the dispatch Policy.
+template <typename Policy, typename MsgBase, typename... ExtraCallbackArgs>
+struct policy_service {
+    using builder_t = policy_builder<
+        Policy, handler_builder<stdx::tuple<>, MsgBase, ExtraCallbackArgs...>>;
+    using interface_t =
+        handler_interface<MsgBase, ExtraCallbackArgs...> const *;
+
+    constexpr static auto uninitialized_v =
+        uninitialized_handler_t<MsgBase, ExtraCallbackArgs...>{};
+    CONSTEVAL static auto uninitialized() -> interface_t {
+        return &uninitialized_v;
+    }
+};
+
+// Like indexed_service, but the handler follows the dispatch Policy.
+template <typename Policy, typename IndexSpec, typename MsgBase,
+          typename... ExtraCallbackArgs>
+struct indexed_policy_service {
+    using builder_t =
+        policy_builder<Policy, indexed_builder<IndexSpec, stdx::tuple<>,
+                                               MsgBase, ExtraCallbackArgs...>>;
+    using interface_t =
+        handler_interface<MsgBase, ExtraCallbackArgs...> const *;
+
+    constexpr static auto uninitialized_v =
+        uninitialized_handler_t<MsgBase, ExtraCallbackArgs...>{};
+    CONSTEVAL static auto uninitialized() -> interface_t {
+        return &uninitialized_v;
+    }
+};
+
+// Like decision_tree_service, but the handler follows the dispatch Policy.
+template <typename Policy, typename MsgBase, typename... ExtraCallbackArgs>
+struct decision_tree_policy_service {
+    using builder_t =
+        policy_builder<Policy, decision_tree_builder<stdx::tuple<>, MsgBase,
+                                                     ExtraCallbackArgs...>>;
+    using interface_t =
+        handler_interface<MsgBase, ExtraCallbackArgs...> const *;
+
+    constexpr static auto uninitialized_v =
+        uninitialized_handler_t<MsgBase, ExtraCallbackArgs...>{};
+    CONSTEVAL static auto uninitialized() -> interface_t {
+        return &uninitialized_v;
+    }
+};
+} // namespace msg
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <msg/handler_builder.hpp>
+#include <msg/handler_interface.hpp>
+#include <msg/indexed_builder.hpp>
+
+#include <stdx/compiler.hpp>
+#include <stdx/panic.hpp>
+#include <stdx/tuple.hpp>
+
+namespace msg {
+template <typename MsgBase, typename... ExtraCallbackArgs>
+using static_handler_t = auto (*)(MsgBase const &, ExtraCallbackArgs...)
+    -> bool;
+
+/**
+ * Wraps a handler builder so that the built service is a plain function
+ * pointer rather than a handler_interface pointer.
+ *
+ * The function calls the concrete (final) handler directly, so the matchers
+ * and callbacks are inlined into it. cib::nexus<Config>::service<S> is the
+ * same function pointer as a constant, so calling through that is a direct
+ * call that can itself be inlined into the receive loop.
+ */
+template <typename Builder, typename MsgBase, typename... ExtraCallbackArgs>
+struct static_handler_builder {
+    Builder builder{};
+
+    template <typename... Ts> [[nodiscard]] constexpr auto add(Ts... ts) {
+        auto new_builder = builder.add(ts...);
+        return static_handler_builder<decltype(new_builder), MsgBase,
+                                      ExtraCallbackArgs...>{new_builder};
+    }
+
+    template <typename BuilderValue> CONSTEVAL static auto build() {
+        return handle<BuilderValue>;
+    }
+
+  private:
+    template <typename BuilderValue> struct inner_value {
+        constexpr static auto value = BuilderValue::value.builder;
+    };
+
+    template <typename BuilderValue>
+    constexpr static auto handler_v =
+        Builder::template build<inner_value<BuilderValue>>();
+
+    template <typename BuilderValue>
+    static auto handle(MsgBase const &msg, ExtraCallbackArgs... args) -> bool {
+        return handler_v<BuilderValue>.handle(msg, args...);
+    }
+};
+
+namespace detail {
+template <typename MsgBase, typename... ExtraCallbackArgs>
+auto uninitialized_static_handle(MsgBase const &, ExtraCallbackArgs...)
+    -> bool {
+    using namespace stdx::literals;
+    stdx::panic<"Attempting to handle msg ("_cts +
+                detail::name_for_msg<MsgBase>() +
+                ") before service is initialized"_cts>();
+    return false;
+}
+} // namespace detail
+
+// Like service, but cib::service<S> is a function pointer: call it as
+// cib::service<S>(msg) rather than cib::service<S>->handle(msg).
+template <typename MsgBase, typename... ExtraCallbackArgs>
+struct static_service {
+    using builder_t = static_handler_builder<
+        handler_builder<stdx::tuple<>, MsgBase, ExtraCallbackArgs...>, MsgBase,
+        ExtraCallbackArgs...>;
+    using interface_t = static_handler_t<MsgBase, ExtraCallbackArgs...>;
+
+    CONSTEVAL static auto uninitialized() -> interface_t {
+        return detail::uninitialized_static_handle<MsgBase,
+                                                   ExtraCallbackArgs...>;
+    }
+};
+
+// Like indexed_service, but cib::service<S> is a function pointer.
+template <typename IndexSpec, typename MsgBase, typename... ExtraCallbackArgs>
+struct static_indexed_service {
+    using builder_t = static_handler_builder<
+        indexed_builder<IndexSpec, stdx::tuple<>, MsgBase,
+                        ExtraCallbackArgs...>,
+        MsgBase, ExtraCallbackArgs...>;
+    using interface_t = static_handler_t<MsgBase, ExtraCallbackArgs...>;
+
+    CONSTEVAL static auto uninitialized() -> interface_t {
+        return detail::uninitialized_static_handle<MsgBase,
+                                                   ExtraCallbackArgs...>;
+    }
+};
+} // namespace msg
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <msg/field.hpp>
+#include <msg/message.hpp>
+
+#include <stdx/ct_string.hpp>
+#include <stdx/span.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace msg {
+namespace detail {
+template <std::endian Order, typename T>
+[[nodiscard]] auto stored_order(T t) -> T {
+    if constexpr (std::integral<T> and sizeof(T) > 1 and
+                  Order != std::endian::native) {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<T>(byteswap(static_cast<U>(t)));
+    } else {
+        return t;
+    }
+}
+
+// iterates over the elements of a section, loading each one as it goes
+template <typename Elements> class elements_iterator {
+    Elements elements{};
+    std::size_t index{};
+
+  public:
+    using value_type = typename Elements::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type;
+    using iterator_category = std::forward_iterator_tag;
+
+    constexpr elements_iterator() = default;
+    constexpr elements_iterator(Elements e, std::size_t i)
+        : elements{e}, index{i} {}
+
+    [[nodiscard]] auto operator*() const -> reference {
+        return elements[index];
+    }
+    constexpr auto operator++() -> elements_iterator & {
+        ++index;
+        return *this;
+    }
+    constexpr auto operator++(int) -> elements_iterator {
+        auto tmp = *this;
+        ++index;
+        return tmp;
+    }
+
+  private:
+    friend constexpr auto operator==(elements_iterator const &lhs,
+                                     elements_iterator const &rhs) -> bool {
+        return lhs.index == rhs.index;
+    }
+};
+} // namespace detail
+
+/**
+ * The elements of a variable-length section, packed back to back in a
+ * message's storage. Elements are read and written in place: there is no
+ * intermediate buffer. Byte is std::byte const for a read-only message.
+ */
+template <typename T, typename Byte, std::endian Order = std::endian::little>
+class packed_elements {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Section elements must be trivially copyable!");
+
+    Byte *first{};
+    std::size_t count{};
+
+  public:
+    using value_type = T;
+
+    constexpr packed_elements() = default;
+    constexpr packed_elements(Byte *p, std::size_t n) : first{p}, count{n} {}
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t { return count; }
+    [[nodiscard]] constexpr auto empty() const -> bool { return count == 0; }
+
+    [[nodiscard]] auto operator[](std::size_t i) const -> T {
+        T t{};
+        std::memcpy(&t, first + i * sizeof(T), sizeof(T));
+        return detail::stored_order<Order>(t);
+    }
+
+    auto set(std::size_t i, T t) const -> void
+        requires(not std::is_const_v<Byte>)
+    {
+        t = detail::stored_order<Order>(t);
+        std::memcpy(first + i * sizeof(T), &t, sizeof(T));
+    }
+
+    // copies as many elements of r as fit into the section
+    template <typename R>
+    auto assign(R const &r) const -> void
+        requires(not std::is_const_v<Byte>)
+    {
+        auto i = std::size_t{};
+        for (auto it = std::begin(r); it != std::end(r) and i < count;
+             ++it, ++i) {
+            set(i, static_cast<T>(*it));
+        }
+    }
+
+    [[nodiscard]] constexpr auto begin() const {
+        return detail::elements_iterator<packed_elements>{*this, 0};
+    }
+    [[nodiscard]] constexpr auto end() const {
+        return detail::elements_iterator<packed_elements>{*this, count};
+    }
+
+    // single-byte elements need no conversion and can be seen directly
+    [[nodiscard]] auto as_span() const
+        requires(std::integral<T> and sizeof(T) == 1)
+    {
+        using elem_t = std::conditional_t<std::is_const_v<Byte>, T const, T>;
+        return stdx::span<elem_t>{reinterpret_cast<elem_t *>(first), count};
+    }
+};
+
+template <std::size_t N> struct fixed_count {
+    constexpr static auto value = N;
+
+    template <std::endian, typename R>
+    [[nodiscard]] constexpr static auto count(R const &) -> std::size_t {
+        return N;
+    }
+};
+
+// the length field is read in the byte order of the message it is in
+template <typename LengthField> struct count_field {
+    template <std::endian Order, typename R>
+    [[nodiscard]] constexpr static auto count(R const &r) -> std::size_t {
+        using field_t =
+            typename detail::stored_q<Order>::template fn<LengthField>;
+        return static_cast<std::size_t>(field_t::extract(r));
+    }
+};
+
+template <stdx::ct_string Name, typename T, typename Count> struct section_t {
+    using name_t = stdx::cts_t<Name>;
+    using value_type = T;
+    using count_t = Count;
+};
+
+template <typename Section>
+concept fixed_section = requires { Section::count_t::value; };
+
+// a section of N elements
+template <stdx::ct_string Name, typename T, std::size_t N>
+using array_field = section_t<Name, T, fixed_count<N>>;
+
+// a section whose number of elements is the value of a (header) field
+template <stdx::ct_string Name, typename T, typename LengthField>
+using repeated_field = section_t<Name, T, count_field<LengthField>>;
+
+template <typename Layout, typename Byte> class layout_view {
+    using sections_t = typename Layout::sections_t;
+    constexpr static auto num_sections =
+        boost::mp11::mp_size<sections_t>::value;
+
+    Byte *base{};
+    std::array<std::size_t, num_sections + 1> offsets{};
+    bool is_valid{};
+
+  public:
+    constexpr layout_view(Byte *b,
+                          std::array<std::size_t, num_sections + 1> const &os,
+                          bool v)
+        : base{b}, offsets{os}, is_valid{v} {}
+
+    // false when the storage is too small for the header or for the sections
+    // its length fields describe; all sections are then empty
+    [[nodiscard]] constexpr auto valid() const -> bool { return is_valid; }
+
+    template <stdx::ct_string N>
+    [[nodiscard]] constexpr auto get(detail::field_name<N>) const {
+        using index_t =
+            boost::mp11::mp_find_if_q<sections_t, detail::matching_name<N>>;
+        static_assert(index_t::value < num_sections,
+                      "Named section not in message!");
+        using T =
+            typename boost::mp11::mp_at<sections_t, index_t>::value_type;
+        constexpr auto i = index_t::value;
+        return packed_elements<T, Byte, Layout::byte_order>{
+            base + offsets[i], (offsets[i + 1] - offsets[i]) / sizeof(T)};
+    }
+
+    [[nodiscard]] constexpr auto offset_of(std::size_t section) const
+        -> std::size_t {
+        return offsets[section];
+    }
+
+    // the size in bytes of the whole message, header included
+    [[nodiscard]] constexpr auto size_bytes() const -> std::size_t {
+        return offsets.back();
+    }
+};
+
+/**
+ * A message with a fixed header (Defn, an ordinary message definition) that
+ * is followed by variable-length sections. Each section starts where the
+ * previous one ends. A view works out every section's offset once, reading
+ * the length fields in the header, and keeps the offsets. If the sections do
+ * not fit in the storage, the view is invalid and its sections are empty.
+ */
+template <typename Defn, typename... Sections> struct variable_message {
+    using definition_t = Defn;
+    using sections_t = boost::mp11::mp_list<Sections...>;
+
+    constexpr static auto byte_order =
+        get_byte_order(typename Defn::env_t{});
+    constexpr static auto header_size =
+        Defn::template size<std::uint8_t>::value;
+
+    // the size in bytes when every section has a fixed number of elements
+    constexpr static auto fixed_size = [] {
+        if constexpr ((... and fixed_section<Sections>)) {
+            return (header_size + ... +
+                    (Sections::count_t::value *
+                     sizeof(typename Sections::value_type)));
+        } else {
+            return std::size_t{};
+        }
+    }();
+
+    template <typename R> [[nodiscard]] static auto view(R &&r) {
+        using elem_t = std::remove_reference_t<decltype(*std::data(r))>;
+        using byte_t = std::conditional_t<std::is_const_v<elem_t>,
+                                          std::byte const, std::byte>;
+
+        // the length fields are not trusted: each section must fit in what
+        // is left of the storage
+        auto const available = std::size(r) * sizeof(elem_t);
+        auto offsets = std::array<std::size_t, sizeof...(Sections) + 1>{};
+        auto i = std::size_t{};
+        auto const fits = [&]<typename S>() {
+            using T = typename S::value_type;
+            auto const n = S::count_t::template count<byte_order>(r);
+            if (n > (available - offsets[i]) / sizeof(T)) {
+                return false;
+            }
+            offsets[i + 1] = offsets[i] + n * sizeof(T);
+            ++i;
+            return true;
+        };
+
+        auto valid = header_size <= available;
+        if (valid) {
+            offsets[0] = header_size;
+            valid = (... and fits.template operator()<Sections>());
+        }
+        if (not valid) {
+            offsets = {};
+        }
+        return layout_view<variable_message, byte_t>{
+            reinterpret_cast<byte_t *>(std::data(r)), offsets, valid};
+    }
+};
+} // namespace msg
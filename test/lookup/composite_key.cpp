@@ -0,0 +1,105 @@
+#include <lookup/composite_key.hpp>
+#include <lookup/eytzinger_lookup.hpp>
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/mph_displace_lookup.hpp>
+#include <lookup/pext_lookup.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/simd_linear_search_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace {
+enum struct color : std::uint8_t { red, green, blue };
+
+using key32_t = lookup::composite_key<std::uint16_t, color, bool>;
+using key64_t = lookup::composite_key<std::uint32_t, std::uint32_t>;
+} // namespace
+
+TEST_CASE("composite key packs its parts", "[composite key]") {
+    constexpr auto k = key32_t{0x1234u, color::blue, true};
+    static_assert(std::is_same_v<key32_t::raw_type, std::uint32_t>);
+    static_assert(sizeof(k) == sizeof(std::uint32_t));
+    static_assert(k.raw == 0x01'02'1234u);
+    static_assert(k.get<0>() == 0x1234u);
+    static_assert(k.get<1>() == color::blue);
+    static_assert(k.get<2>());
+}
+
+TEST_CASE("composite keys compare by all parts", "[composite key]") {
+    static_assert(key64_t{1u, 2u} == key64_t{1u, 2u});
+    static_assert(key64_t{1u, 2u} != key64_t{2u, 1u});
+    static_assert(key64_t{2u, 1u} < key64_t{1u, 2u});
+}
+
+TEMPLATE_TEST_CASE("lookup with composite keys", "[composite key]",
+                   lookup::pseudo_pext_lookup<>,
+                   lookup::pseudo_pext_lookup<true, 2>, lookup::pext_lookup<>,
+                   lookup::mph_displace_lookup<>, lookup::eytzinger_lookup<>) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<key64_t, int, 4>{
+            -1, std::array{lookup::entry{key64_t{1u, 2u}, 1},
+                           lookup::entry{key64_t{2u, 1u}, 2},
+                           lookup::entry{key64_t{1u, 1u}, 3},
+                           lookup::entry{key64_t{2u, 2u}, 4}}}));
+
+    CHECK(lookup[key64_t{1u, 2u}] == 1);
+    CHECK(lookup[key64_t{2u, 1u}] == 2);
+    CHECK(lookup[key64_t{1u, 1u}] == 3);
+    CHECK(lookup[key64_t{2u, 2u}] == 4);
+    CHECK(lookup[key64_t{3u, 1u}] == -1);
+}
+
+#if defined(__SIZEOF_INT128__)
+namespace {
+using key128_t = lookup::composite_key<std::uint64_t, std::uint32_t>;
+}
+
+TEMPLATE_TEST_CASE("lookup with 128-bit composite keys", "[composite key]",
+                   lookup::pseudo_pext_lookup<>,
+                   lookup::pseudo_pext_lookup<true, 2>, lookup::pext_lookup<>,
+                   lookup::mph_displace_lookup<>, lookup::eytzinger_lookup<>,
+                   lookup::linear_search_lookup<8>,
+                   lookup::simd_linear_search_lookup<8>) {
+    static_assert(sizeof(key128_t) == 16);
+    static_assert(
+        not lookup::detail::simd_supports_key<lookup::detail::uint128_t>);
+
+    // keys that differ only in bits above 64
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<key128_t, int, 5>{
+            -1, std::array{lookup::entry{key128_t{7u, 1u}, 1},
+                           lookup::entry{key128_t{7u, 2u}, 2},
+                           lookup::entry{key128_t{7u, 0x8000'0000u}, 3},
+                           lookup::entry{key128_t{1ull << 63u, 1u}, 4},
+                           lookup::entry{key128_t{0u, 0u}, 5}}}));
+
+    CHECK(lookup[key128_t{7u, 1u}] == 1);
+    CHECK(lookup[key128_t{7u, 2u}] == 2);
+    CHECK(lookup[key128_t{7u, 0x8000'0000u}] == 3);
+    CHECK(lookup[key128_t{1ull << 63u, 1u}] == 4);
+    CHECK(lookup[key128_t{0u, 0u}] == 5);
+    CHECK(lookup[key128_t{7u, 3u}] == -1);
+    CHECK(lookup[key128_t{8u, 1u}] == -1);
+}
+
+TEST_CASE("128-bit raw integral keys", "[composite key]") {
+    using u128 = lookup::detail::uint128_t;
+    constexpr auto lookup = lookup::pseudo_pext_lookup<>::make(
+        CX_VALUE(lookup::input<u128, int, 3>{
+            0, std::array{lookup::entry{u128{1} << 100u, 1},
+                          lookup::entry{u128{1} << 101u, 2},
+                          lookup::entry{u128{3}, 3}}}));
+
+    CHECK(lookup[u128{1} << 100u] == 1);
+    CHECK(lookup[u128{1} << 101u] == 2);
+    CHECK(lookup[u128{3}] == 3);
+    CHECK(lookup[u128{1}] == 0);
+}
+#endif
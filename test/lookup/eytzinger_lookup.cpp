@@ -0,0 +1,146 @@
+#include <lookup/eytzinger_lookup.hpp>
+#include <lookup/input.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+using exact = lookup::eytzinger_lookup<>;
+using ranged = lookup::eytzinger_lookup<true>;
+
+TEMPLATE_TEST_CASE("lookup with no entries", "[eytzinger lookup]", exact,
+                   ranged) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint32_t>{5}));
+
+    static_assert(lookup[0] == 5);
+    CHECK(lookup[0] == 5);
+    CHECK(lookup[54] == 5);
+}
+
+TEST_CASE("exact lookup with some entries", "[eytzinger lookup]") {
+    constexpr auto lookup =
+        exact::make(CX_VALUE(lookup::input<std::uint32_t, int, 3>{
+            0, std::array{lookup::entry{54u, 1}, lookup::entry{324u, 2},
+                          lookup::entry{64u, 3}}}));
+
+    static_assert(lookup[324] == 2);
+    CHECK(lookup[0] == 0);
+    CHECK(lookup[54] == 1);
+    CHECK(lookup[55] == 0);
+    CHECK(lookup[64] == 3);
+    CHECK(lookup[324] == 2);
+    CHECK(lookup[1000] == 0);
+}
+
+TEST_CASE("ranged lookup with some entries", "[eytzinger lookup]") {
+    constexpr auto lookup =
+        ranged::make(CX_VALUE(lookup::input<std::uint32_t, int, 3>{
+            -1, std::array{lookup::entry{10u, 1}, lookup::entry{20u, 2},
+                           lookup::entry{30u, 3}}}));
+
+    static_assert(lookup[25] == 2);
+    CHECK(lookup[0] == -1);
+    CHECK(lookup[9] == -1);
+    CHECK(lookup[10] == 1);
+    CHECK(lookup[19] == 1);
+    CHECK(lookup[20] == 2);
+    CHECK(lookup[29] == 2);
+    CHECK(lookup[30] == 3);
+    CHECK(lookup[std::numeric_limits<std::uint32_t>::max()] == 3);
+}
+
+TEMPLATE_TEST_CASE("lookup with the maximum key", "[eytzinger lookup]", exact,
+                   ranged) {
+    constexpr auto max = std::numeric_limits<std::uint8_t>::max();
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint8_t, int, 2>{
+            0, std::array{lookup::entry<std::uint8_t, int>{1, 1},
+                          lookup::entry<std::uint8_t, int>{max, 2}}}));
+
+    CHECK(lookup[1] == 1);
+    CHECK(lookup[max] == 2);
+}
+
+TEST_CASE("exact lookup of the maximum key when it is absent",
+          "[eytzinger lookup]") {
+    constexpr auto max = std::numeric_limits<std::uint8_t>::max();
+    constexpr auto lookup =
+        exact::make(CX_VALUE(lookup::input<std::uint8_t, int, 2>{
+            0, std::array{lookup::entry<std::uint8_t, int>{1, 1},
+                          lookup::entry<std::uint8_t, int>{2, 2}}}));
+
+    CHECK(lookup[max] == 0);
+}
+
+TEST_CASE("ranged lookup with signed keys", "[eytzinger lookup]") {
+    constexpr auto lookup = ranged::make(CX_VALUE(lookup::input<int, int, 3>{
+        0, std::array{lookup::entry{-100, 1}, lookup::entry{0, 2},
+                      lookup::entry{100, 3}}}));
+
+    CHECK(lookup[-101] == 0);
+    CHECK(lookup[-100] == 1);
+    CHECK(lookup[-1] == 1);
+    CHECK(lookup[0] == 2);
+    CHECK(lookup[99] == 2);
+    CHECK(lookup[100] == 3);
+}
+
+enum class some_key_t : std::uint16_t { ALPHA, BETA, KAPPA, GAMMA };
+
+TEST_CASE("exact lookup with scoped enum entries", "[eytzinger lookup]") {
+    constexpr auto lookup =
+        exact::make(CX_VALUE(lookup::input<some_key_t, std::int8_t, 3>{
+            0, std::array{
+                   lookup::entry<some_key_t, int8_t>{some_key_t::ALPHA, 54},
+                   lookup::entry<some_key_t, int8_t>{some_key_t::KAPPA, 87},
+                   lookup::entry<some_key_t, int8_t>{some_key_t::GAMMA, 4}}}));
+
+    CHECK(lookup[some_key_t::ALPHA] == 54);
+    CHECK(lookup[some_key_t::BETA] == 0);
+    CHECK(lookup[some_key_t::KAPPA] == 87);
+    CHECK(lookup[some_key_t::GAMMA] == 4);
+}
+
+namespace {
+constexpr auto num_large_entries = std::size_t{1000};
+
+constexpr auto large_input = []() {
+    lookup::input<std::uint32_t, std::uint32_t, num_large_entries> in{
+        0xffff'ffffu};
+    for (auto i = std::size_t{}; i < num_large_entries; i++) {
+        // insert in descending order to exercise sorting
+        auto const n = num_large_entries - i;
+        in.entries[i] = {static_cast<std::uint32_t>(n * 10u),
+                         static_cast<std::uint32_t>(n)};
+    }
+    return in;
+}();
+} // namespace
+
+TEST_CASE("exact lookup with a large number of entries", "[eytzinger lookup]") {
+    constexpr static auto lookup = exact::make(CX_VALUE(large_input));
+
+    for (auto const &[k, v] : large_input.entries) {
+        CHECK(lookup[k] == v);
+        CHECK(lookup[k + 1] == 0xffff'ffffu);
+    }
+}
+
+TEST_CASE("ranged lookup with a large number of entries",
+          "[eytzinger lookup]") {
+    constexpr static auto lookup = ranged::make(CX_VALUE(large_input));
+
+    CHECK(lookup[0] == 0xffff'ffffu);
+    CHECK(lookup[9] == 0xffff'ffffu);
+    for (auto const &[k, v] : large_input.entries) {
+        CHECK(lookup[k] == v);
+        CHECK(lookup[k + 9] == v);
+    }
+}
@@ -39,3 +39,16 @@ TEST_CASE("a lookup with non-integer values", "[linear_search]") {
     CHECK(lookup[1u] == 17.0f);
     CHECK(lookup[2u] == 42.0f);
 }
+
+TEST_CASE("a batch lookup", "[linear_search]") {
+    constexpr auto lookup =
+        LS::make(CX_VALUE(lookup::input<std::uint32_t, std::uint32_t, 2>{
+            11u, std::array{lookup::entry{1u, 17u}, lookup::entry{2u, 42u}}}));
+
+    auto const keys =
+        std::array<std::uint32_t, 10>{0u, 1u, 2u, 3u, 2u, 1u, 0u, 1u, 2u, 5u};
+    auto values = std::array<std::uint32_t, 10>{};
+    lookup.lookup(keys, values);
+    CHECK(values == std::array<std::uint32_t, 10>{11u, 17u, 42u, 11u, 42u, 17u,
+                                                  11u, 17u, 42u, 11u});
+}
@@ -9,6 +9,7 @@
 
 #include <array>
 #include <cstdint>
+#include <type_traits>
 
 TEST_CASE("a lookup with no entries", "[lookup]") {
     constexpr auto lookup =
@@ -95,3 +96,94 @@ TEST_CASE("a lookup with some sequential entries", "[lookup]") {
     static_assert(lookup[15] == 1);
     static_assert(lookup[4'000'000'000u] == 1);
 }
+
+namespace {
+constexpr auto sequential_input =
+    lookup::input<std::uint32_t, std::uint32_t, 10>{
+        1u, std::array{lookup::entry{0u, 13u}, lookup::entry{1u, 42u},
+                       lookup::entry{2u, 10u}, lookup::entry{3u, 76u},
+                       lookup::entry{4u, 25u}, lookup::entry{5u, 82u},
+                       lookup::entry{6u, 18u}, lookup::entry{7u, 87u},
+                       lookup::entry{8u, 55u}, lookup::entry{9u, 11u}}};
+
+template <typename Lookup> constexpr auto check_sequential(Lookup const &l) {
+    for (auto const &[k, v] : sequential_input.entries) {
+        if (l[k] != v) {
+            return false;
+        }
+    }
+    return l[10u] == 1u and l[4'000'000'000u] == 1u;
+}
+} // namespace
+
+TEST_CASE("a lookup optimized for size", "[lookup]") {
+    constexpr auto lookup =
+        lookup::make<lookup::optimize_for::size>(CX_VALUE(sequential_input));
+    static_assert(check_sequential(lookup));
+
+    constexpr auto linear = lookup::linear_search_lookup<16>::make(
+        CX_VALUE(sequential_input));
+    constexpr auto direct =
+        lookup::pseudo_pext_lookup<>::make(CX_VALUE(sequential_input));
+    static_assert(lookup::cost_of(lookup).storage_bytes <=
+                  lookup::cost_of(linear).storage_bytes);
+    static_assert(lookup::cost_of(lookup).storage_bytes <=
+                  lookup::cost_of(direct).storage_bytes);
+}
+
+TEST_CASE("a lookup optimized for latency", "[lookup]") {
+    constexpr auto lookup = lookup::make<lookup::optimize_for::latency>(
+        CX_VALUE(sequential_input));
+    static_assert(check_sequential(lookup));
+    static_assert(lookup::cost_of(lookup).max_probes == 1);
+}
+
+TEST_CASE("a lookup with a weighted cost", "[lookup]") {
+    constexpr auto lookup = lookup::make<lookup::optimize_for::weighted<8>>(
+        CX_VALUE(sequential_input));
+    static_assert(check_sequential(lookup));
+}
+
+TEST_CASE("an optimized lookup with no entries", "[lookup]") {
+    constexpr auto lookup = lookup::make<lookup::optimize_for::size>(
+        CX_VALUE(lookup::input<std::uint32_t>{5u}));
+    static_assert(lookup[0u] == 5u);
+    static_assert(lookup[42u] == 5u);
+}
+
+namespace {
+struct fewest_total_bytes {
+    [[nodiscard]] constexpr static auto cost(lookup::cost_t c) {
+        return c.storage_bytes;
+    }
+};
+} // namespace
+
+TEST_CASE("a lookup with a user-supplied policy", "[lookup]") {
+    constexpr auto lookup =
+        lookup::make<fewest_total_bytes>(CX_VALUE(sequential_input));
+    static_assert(check_sequential(lookup));
+}
+
+TEST_CASE("best_of picks the cheapest strategy", "[lookup]") {
+    using small_first = lookup::best_of<lookup::optimize_for::size,
+                                        lookup::pseudo_pext_lookup<>,
+                                        lookup::linear_search_lookup<16>>;
+    constexpr auto lookup = small_first::make(CX_VALUE(sequential_input));
+    constexpr auto linear = lookup::linear_search_lookup<16>::make(
+        CX_VALUE(sequential_input));
+    constexpr auto direct =
+        lookup::pseudo_pext_lookup<>::make(CX_VALUE(sequential_input));
+    static_assert(
+        std::is_same_v<decltype(lookup),
+                       std::conditional_t<sizeof(linear) < sizeof(direct),
+                                          decltype(linear),
+                                          decltype(direct)> const>);
+}
+
+TEST_CASE("best_of skips failed strategies", "[lookup]") {
+    using best = lookup::best_of<lookup::optimize_for::size,
+                                 lookup::linear_search_lookup<2>>;
+    constexpr auto lookup = best::make(CX_VALUE(sequential_input));
+    static_assert(lookup::strategy_failed(lookup));
+}
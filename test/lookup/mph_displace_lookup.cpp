@@ -0,0 +1,102 @@
+#include <lookup/input.hpp>
+#include <lookup/mph_displace_lookup.hpp>
+#include <lookup/strategies.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+using mph_displace_1 = lookup::mph_displace_lookup<1>;
+using mph_displace_4 = lookup::mph_displace_lookup<4>;
+using mph_displace_8 = lookup::mph_displace_lookup<8>;
+
+TEMPLATE_TEST_CASE("lookup with some entries", "[mph displace lookup]",
+                   mph_displace_1, mph_displace_4, mph_displace_8) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint32_t, int, 3>{
+            0, std::array{lookup::entry{54u, 1}, lookup::entry{324u, 2},
+                          lookup::entry{64u, 3}}}));
+
+    static_assert(lookup[324] == 2);
+    CHECK(lookup[0] == 0);
+    CHECK(lookup[54] == 1);
+    CHECK(lookup[324] == 2);
+    CHECK(lookup[64] == 3);
+}
+
+TEMPLATE_TEST_CASE("lookup with no entries", "[mph displace lookup]",
+                   mph_displace_1, mph_displace_4, mph_displace_8) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint32_t>{5}));
+
+    CHECK(lookup[0] == 5);
+    CHECK(lookup[54] == 5);
+}
+
+enum class some_key_t : std::uint16_t { ALPHA, BETA, KAPPA, GAMMA };
+
+TEST_CASE("lookup with scoped enum entries", "[mph displace lookup]") {
+    constexpr auto lookup = mph_displace_4::make(
+        CX_VALUE(lookup::input<some_key_t, std::int8_t, 4>{
+            0, std::array{
+                   lookup::entry<some_key_t, int8_t>{some_key_t::ALPHA, 54},
+                   lookup::entry<some_key_t, int8_t>{some_key_t::BETA, 23},
+                   lookup::entry<some_key_t, int8_t>{some_key_t::KAPPA, 87},
+                   lookup::entry<some_key_t, int8_t>{some_key_t::GAMMA, 4}}}));
+
+    CHECK(lookup[some_key_t::ALPHA] == 54);
+    CHECK(lookup[some_key_t::BETA] == 23);
+    CHECK(lookup[some_key_t::KAPPA] == 87);
+    CHECK(lookup[some_key_t::GAMMA] == 4);
+}
+
+namespace {
+// the pilot search is costly to evaluate at compile time: keep this within
+// the compilers' default constexpr limits
+constexpr auto num_large_entries = std::size_t{40};
+
+constexpr auto large_input = []() {
+    lookup::input<std::uint32_t, std::uint32_t, num_large_entries> in{
+        0xffff'ffffu};
+    for (auto i = std::size_t{}; i < num_large_entries; i++) {
+        auto const k = static_cast<std::uint32_t>(i * 7919u + 13u);
+        in.entries[i] = {k, static_cast<std::uint32_t>(i)};
+    }
+    return in;
+}();
+} // namespace
+
+TEST_CASE("lookup with many entries", "[mph displace lookup]") {
+    constexpr static auto lookup = mph_displace_4::make(CX_VALUE(large_input));
+    static_assert(not lookup::strategy_failed(lookup));
+    static_assert(std::size(lookup.storage) == num_large_entries);
+
+    for (auto const &[k, v] : large_input.entries) {
+        CHECK(lookup[k] == v);
+    }
+    CHECK(lookup[1] == 0xffff'ffffu);
+    CHECK(lookup[12] == 0xffff'ffffu);
+}
+
+TEST_CASE("mph displace lookup is selectable through strategies",
+          "[mph displace lookup]") {
+    constexpr auto lookup =
+        lookup::strategies<lookup::mph_displace_lookup<>>::make(
+            CX_VALUE(lookup::input<std::uint16_t, std::uint16_t, 5>{
+                7, std::array<lookup::entry<std::uint16_t, std::uint16_t>, 5>{
+                       lookup::entry<std::uint16_t, std::uint16_t>{1, 0},
+                       lookup::entry<std::uint16_t, std::uint16_t>{3, 0},
+                       lookup::entry<std::uint16_t, std::uint16_t>{11, 0},
+                       lookup::entry<std::uint16_t, std::uint16_t>{16, 0},
+                       lookup::entry<std::uint16_t, std::uint16_t>{0, 1}}}));
+
+    static_assert(not lookup::strategy_failed(lookup));
+    CHECK(lookup[0] == 1);
+    CHECK(lookup[11] == 0);
+    CHECK(lookup[2] == 7);
+}
@@ -0,0 +1,108 @@
+#include <lookup/input.hpp>
+#include <lookup/pext_lookup.hpp>
+#include <lookup/strategies.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+
+using pext_direct = lookup::pext_lookup<>;
+using pext_indirect_1 = lookup::pext_lookup<true, 1>;
+using pext_indirect_2 = lookup::pext_lookup<true, 2>;
+using pext_indirect_3 = lookup::pext_lookup<true, 3>;
+
+TEST_CASE("software pext extracts masked bits", "[pext lookup]") {
+    static_assert(lookup::detail::software_pext<std::uint32_t>(0, 0) == 0);
+    static_assert(lookup::detail::software_pext<std::uint32_t>(
+                      0b1011'0110u, 0b1111'0000u) == 0b1011u);
+    static_assert(lookup::detail::software_pext<std::uint32_t>(
+                      0b1011'0110u, 0b1010'1010u) == 0b1101u);
+    static_assert(lookup::detail::software_pext<std::uint64_t>(
+                      0x8000'0000'0000'0001ull, 0x8000'0000'0000'0001ull) ==
+                  0b11u);
+}
+
+TEST_CASE("pext matches software pext at runtime", "[pext lookup]") {
+    auto const p = lookup::detail::pext_t<std::uint32_t>{0x00ff'0f0fu};
+    for (auto v : {0u, 1u, 0x1234'5678u, 0xffff'ffffu, 0xdead'beefu}) {
+        CHECK(p(v) == lookup::detail::software_pext(v, 0x00ff'0f0fu));
+    }
+}
+
+TEMPLATE_TEST_CASE("lookup with some entries", "[pext lookup]", pext_direct,
+                   pext_indirect_1, pext_indirect_2, pext_indirect_3) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint32_t, int, 3>{
+            0, std::array{lookup::entry{54u, 1}, lookup::entry{324u, 2},
+                          lookup::entry{64u, 3}}}));
+
+    static_assert(lookup[54] == 1);
+    CHECK(lookup[0] == 0);
+    CHECK(lookup[54] == 1);
+    CHECK(lookup[324] == 2);
+    CHECK(lookup[64] == 3);
+}
+
+TEMPLATE_TEST_CASE("lookup with no entries", "[pext lookup]", pext_direct,
+                   pext_indirect_1, pext_indirect_2, pext_indirect_3) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint32_t>{0}));
+
+    CHECK(lookup[0] == 0);
+    CHECK(lookup[54] == 0);
+}
+
+TEMPLATE_TEST_CASE("lookup with 64-bit keys", "[pext lookup]", pext_direct,
+                   pext_indirect_2) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint64_t, int, 4>{
+            -1, std::array<lookup::entry<std::uint64_t, int>, 4>{
+                    lookup::entry<std::uint64_t, int>{0x1'0000'0000u, 1},
+                    lookup::entry<std::uint64_t, int>{0x2'0000'0000u, 2},
+                    lookup::entry<std::uint64_t, int>{
+                        0x8000'0000'0000'0000u, 3},
+                    lookup::entry<std::uint64_t, int>{17u, 4}}}));
+
+    CHECK(lookup[0x1'0000'0000u] == 1);
+    CHECK(lookup[0x2'0000'0000u] == 2);
+    CHECK(lookup[0x8000'0000'0000'0000u] == 3);
+    CHECK(lookup[17u] == 4);
+    CHECK(lookup[18u] == -1);
+}
+
+TEST_CASE("pext lookup is selectable through strategies", "[pext lookup]") {
+    constexpr auto lookup =
+        lookup::strategies<lookup::pext_lookup<true, 2>>::make(
+            CX_VALUE(lookup::input<std::uint16_t, std::uint16_t, 5>{
+                7, std::array<lookup::entry<std::uint16_t, std::uint16_t>, 5>{
+                       lookup::entry<std::uint16_t, std::uint16_t>{1, 0},
+                       lookup::entry<std::uint16_t, std::uint16_t>{3, 0},
+                       lookup::entry<std::uint16_t, std::uint16_t>{11, 0},
+                       lookup::entry<std::uint16_t, std::uint16_t>{16, 0},
+                       lookup::entry<std::uint16_t, std::uint16_t>{0, 1}}}));
+
+    static_assert(not lookup::strategy_failed(lookup));
+    CHECK(lookup[1] == 0);
+    CHECK(lookup[3] == 0);
+    CHECK(lookup[11] == 0);
+    CHECK(lookup[16] == 0);
+    CHECK(lookup[0] == 1);
+    CHECK(lookup[2] == 7);
+}
+
+TEST_CASE("pext lookup supports batch lookup", "[pext lookup]") {
+    constexpr auto lookup = lookup::pext_lookup<true, 2>::make(
+        CX_VALUE(lookup::input<std::uint32_t, int, 4>{
+            -1, std::array{lookup::entry{54u, 1}, lookup::entry{324u, 2},
+                           lookup::entry{64u, 3}, lookup::entry{91u, 4}}}));
+
+    auto const keys = std::array<std::uint32_t, 9>{54, 324, 64, 91, 0,
+                                                   91, 64, 324, 54};
+    auto values = std::array<int, 9>{};
+    lookup.lookup(keys, values);
+    CHECK(values == std::array{1, 2, 3, 4, -1, 4, 3, 2, 1});
+}
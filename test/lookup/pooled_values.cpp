@@ -0,0 +1,106 @@
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/pooled_values.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <stdx/bitset.hpp>
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+using bitset = stdx::bitset<256, std::uint32_t>;
+
+constexpr auto shared_values = []() {
+    lookup::input<std::uint32_t, bitset, 64> in{bitset{stdx::place_bits, 255}};
+    for (auto i = std::size_t{}; i < in.entries.size(); i++) {
+        auto const k = static_cast<std::uint32_t>(i * 37u + 5u);
+        in.entries[i] = {k, bitset{stdx::place_bits, i % 3u, 200}};
+    }
+    return in;
+}();
+} // namespace
+
+TEST_CASE("value pool holds each distinct value once", "[pooled values]") {
+    constexpr auto original = CX_VALUE(lookup::input<int, int, 4>{
+        7, std::array{lookup::entry{1, 10}, lookup::entry{2, 7},
+                      lookup::entry{3, 10}, lookup::entry{4, 11}}});
+    using input_t = lookup::detail::pooled_input<decltype(original)>;
+    static_assert(input_t::pool == std::array{7, 10, 11});
+    static_assert(std::is_same_v<input_t::index_t, std::uint8_t>);
+
+    constexpr auto indexed = input_t{}();
+    static_assert(indexed.default_value == 0);
+    static_assert(indexed.entries[0].value_ == 1);
+    static_assert(indexed.entries[1].value_ == 0);
+    static_assert(indexed.entries[2].value_ == 1);
+    static_assert(indexed.entries[3].value_ == 2);
+}
+
+TEST_CASE("pooled lookup with some entries", "[pooled values]") {
+    constexpr auto lookup =
+        lookup::pooled_values<lookup::linear_search_lookup<4>>::make(
+            CX_VALUE(lookup::input<std::uint32_t, int, 3>{
+                0, std::array{lookup::entry{54u, 1}, lookup::entry{324u, 2},
+                              lookup::entry{64u, 1}}}));
+
+    static_assert(lookup[54u] == 1);
+    CHECK(lookup[0u] == 0);
+    CHECK(lookup[54u] == 1);
+    CHECK(lookup[324u] == 2);
+    CHECK(lookup[64u] == 1);
+}
+
+TEST_CASE("pooled lookup with no entries", "[pooled values]") {
+    constexpr auto lookup =
+        lookup::pooled_values<lookup::pseudo_pext_lookup<true, 2>>::make(
+            CX_VALUE(lookup::input<std::uint32_t>{5u}));
+
+    CHECK(lookup[0u] == 5u);
+    CHECK(lookup[54u] == 5u);
+}
+
+TEST_CASE("pooled lookup fails when the wrapped strategy fails",
+          "[pooled values]") {
+    constexpr auto lookup =
+        lookup::pooled_values<lookup::linear_search_lookup<2>>::make(
+            CX_VALUE(lookup::input<int, int, 3>{
+                0, std::array{lookup::entry{1, 1}, lookup::entry{2, 2},
+                              lookup::entry{3, 3}}}));
+    static_assert(lookup::strategy_failed(lookup));
+}
+
+TEST_CASE("pooled lookup of shared bitsets is smaller", "[pooled values]") {
+    using strategy = lookup::pseudo_pext_lookup<true, 2>;
+    constexpr auto plain = strategy::make(CX_VALUE(shared_values));
+    constexpr auto pooled =
+        lookup::pooled_values<strategy>::make(CX_VALUE(shared_values));
+
+    static_assert(sizeof(pooled) < sizeof(plain));
+    static_assert(std::size(pooled.pool) == 4);
+
+    for (auto const &[k, v] : shared_values.entries) {
+        CHECK(pooled[k] == v);
+        CHECK(pooled[k + 1] == shared_values.default_value);
+    }
+}
+
+TEST_CASE("pooled values are chosen by size-optimized make",
+          "[pooled values]") {
+    constexpr auto lookup = lookup::make<lookup::optimize_for::size>(
+        CX_VALUE(shared_values));
+    constexpr auto pooled =
+        lookup::pooled_values<lookup::pseudo_pext_lookup<true, 2>>::make(
+            CX_VALUE(shared_values));
+    static_assert(sizeof(lookup) <= sizeof(pooled));
+
+    for (auto const &[k, v] : shared_values.entries) {
+        CHECK(lookup[k] == v);
+    }
+}
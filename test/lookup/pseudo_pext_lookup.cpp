@@ -40,6 +40,40 @@ TEMPLATE_TEST_CASE("lookup with no entries", "[pseudo pext lookup]",
     CHECK(lookup[64] == 0);
 }
 
+TEMPLATE_TEST_CASE("batch lookup", "[pseudo pext lookup]", pseudo_pext_direct,
+                   pseudo_pext_indirect_1, pseudo_pext_indirect_2,
+                   pseudo_pext_indirect_3, pseudo_pext_indirect_4) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint32_t, int, 5>{
+            -1, std::array{lookup::entry{54u, 1}, lookup::entry{324u, 2},
+                           lookup::entry{64u, 3}, lookup::entry{234u, 4},
+                           lookup::entry{91u, 5}}}));
+
+    // more keys than one batch, with a partial batch at the end
+    auto const keys =
+        std::array<std::uint32_t, 11>{54, 0, 324, 64, 234, 91, 91, 7,
+                                      64, 324, 54};
+    auto values = std::array<int, 11>{};
+    lookup.lookup(keys, values);
+
+    for (auto i = std::size_t{}; i < keys.size(); i++) {
+        CHECK(values[i] == lookup[keys[i]]);
+    }
+    CHECK(values[1] == -1);
+    CHECK(values[10] == 1);
+}
+
+TEMPLATE_TEST_CASE("batch lookup with no entries", "[pseudo pext lookup]",
+                   pseudo_pext_direct, pseudo_pext_indirect_1) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<uint32_t>{0}));
+
+    auto const keys = std::array<std::uint32_t, 3>{54, 324, 64};
+    auto values = std::array<std::uint32_t, 3>{1, 2, 3};
+    lookup.lookup(keys, values);
+    CHECK(values == std::array<std::uint32_t, 3>{});
+}
+
 TEMPLATE_TEST_CASE("lookup with non-integral values", "[pseudo pext lookup]",
                    pseudo_pext_direct, pseudo_pext_indirect_1,
                    pseudo_pext_indirect_2, pseudo_pext_indirect_3,
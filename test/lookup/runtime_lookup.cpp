@@ -0,0 +1,122 @@
+#include <lookup/entry.hpp>
+#include <lookup/runtime_lookup.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace {
+using runtime_direct =
+    lookup::runtime_pseudo_pext_lookup<std::uint32_t, int, false, 1>;
+using runtime_indirect_1 =
+    lookup::runtime_pseudo_pext_lookup<std::uint32_t, int, true, 1>;
+using runtime_indirect_2 =
+    lookup::runtime_pseudo_pext_lookup<std::uint32_t, int, true, 2>;
+using runtime_indirect_4 =
+    lookup::runtime_pseudo_pext_lookup<std::uint32_t, int, true, 4>;
+
+constexpr auto some_entries =
+    std::array{lookup::entry{54u, 1}, lookup::entry{324u, 2},
+               lookup::entry{64u, 3}, lookup::entry{6134u, 4},
+               lookup::entry{0x8000'0000u, 5}, lookup::entry{17u, 6}};
+} // namespace
+
+TEST_CASE("runtime linear search lookup", "[runtime lookup]") {
+    auto const lookup =
+        lookup::runtime_linear_search_lookup<std::uint32_t, int>{
+            0, some_entries};
+
+    CHECK(lookup[0] == 0);
+    CHECK(lookup[54] == 1);
+    CHECK(lookup[6134] == 4);
+    CHECK(lookup[17] == 6);
+}
+
+TEMPLATE_TEST_CASE("runtime pseudo pext lookup with some entries",
+                   "[runtime lookup]", runtime_direct, runtime_indirect_1,
+                   runtime_indirect_2, runtime_indirect_4) {
+    static auto buffers =
+        lookup::runtime_pseudo_pext_buffers<TestType, 16, 256>{};
+    auto const lookup = buffers.build(-1, some_entries);
+    REQUIRE(lookup.has_value());
+
+    CHECK((*lookup)[0] == -1);
+    CHECK((*lookup)[55] == -1);
+    for (auto e : some_entries) {
+        CHECK((*lookup)[e.key_] == e.value_);
+    }
+}
+
+TEMPLATE_TEST_CASE("runtime pseudo pext lookup with no entries",
+                   "[runtime lookup]", runtime_direct, runtime_indirect_2) {
+    static auto buffers = lookup::runtime_pseudo_pext_buffers<TestType, 4, 4>{};
+    auto const lookup =
+        buffers.build(42, std::span<lookup::entry<std::uint32_t, int> const>{});
+    REQUIRE(lookup.has_value());
+
+    CHECK((*lookup)[0] == 42);
+    CHECK((*lookup)[1] == 42);
+}
+
+TEST_CASE("runtime pseudo pext lookup matches the compile-time mask",
+          "[runtime lookup]") {
+    static auto buffers =
+        lookup::runtime_pseudo_pext_buffers<runtime_indirect_2, 16, 256>{};
+    auto const lookup = buffers.build(0, some_entries);
+    REQUIRE(lookup.has_value());
+
+    constexpr auto expected =
+        lookup::detail::calc_pseudo_pext_mask(some_entries, 2);
+    CHECK(lookup->pext_func.mask == std::get<0>(expected));
+    CHECK(lookup->search_len == std::get<1>(expected) + 1);
+}
+
+TEST_CASE("runtime pseudo pext lookup rejects duplicate keys",
+          "[runtime lookup]") {
+    static auto buffers =
+        lookup::runtime_pseudo_pext_buffers<runtime_indirect_2, 4, 16>{};
+    auto const entries =
+        std::array{lookup::entry{1u, 1}, lookup::entry{2u, 2},
+                   lookup::entry{1u, 3}};
+    CHECK(not buffers.build(0, entries).has_value());
+}
+
+TEST_CASE("runtime pseudo pext lookup rejects storage that is too small",
+          "[runtime lookup]") {
+    static auto small_table =
+        lookup::runtime_pseudo_pext_buffers<runtime_indirect_1, 16, 2>{};
+    CHECK(not small_table.build(0, some_entries).has_value());
+
+    static auto too_many_entries =
+        lookup::runtime_pseudo_pext_buffers<runtime_indirect_2, 4, 256>{};
+    CHECK(not too_many_entries.build(0, some_entries).has_value());
+}
+
+TEST_CASE("runtime pseudo pext lookup can be built at compile time",
+          "[runtime lookup]") {
+    constexpr auto v = [] {
+        auto buffers =
+            lookup::runtime_pseudo_pext_buffers<runtime_indirect_2, 16, 256>{};
+        auto const lookup = buffers.build(0, some_entries);
+        return (*lookup)[324] + (*lookup)[1];
+    }();
+    static_assert(v == 2);
+}
+
+TEMPLATE_TEST_CASE("runtime pseudo pext batch lookup", "[runtime lookup]",
+                   runtime_direct, runtime_indirect_2) {
+    static auto buffers =
+        lookup::runtime_pseudo_pext_buffers<TestType, 16, 256>{};
+    auto const lookup = buffers.build(-1, some_entries);
+    REQUIRE(lookup.has_value());
+
+    auto const keys = std::array<std::uint32_t, 10>{
+        54u, 1u, 324u, 64u, 2u, 6134u, 17u, 3u, 0x8000'0000u, 54u};
+    auto values = std::array<int, 10>{};
+    lookup->lookup(keys, values);
+    CHECK(values == std::array{1, -1, 2, 3, -1, 4, 6, -1, 5, 1});
+}
@@ -0,0 +1,102 @@
+#include <lookup/input.hpp>
+#include <lookup/simd_linear_search_lookup.hpp>
+#include <lookup/strategies.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+using LS = lookup::simd_linear_search_lookup<64>;
+
+template <typename K, std::size_t N>
+constexpr auto make_input = []() {
+    lookup::input<K, int, N> in{-1};
+    for (auto i = std::size_t{}; i < N; i++) {
+        in.entries[i] = {static_cast<K>(i * 3u + 1u), static_cast<int>(i)};
+    }
+    return in;
+}();
+
+template <typename K, std::size_t N> auto check_all() {
+    constexpr static auto lookup = LS::make(CX_VALUE(make_input<K, N>));
+    for (auto i = std::size_t{}; i < N; i++) {
+        CHECK(lookup[static_cast<K>(i * 3u + 1u)] == static_cast<int>(i));
+        CHECK(lookup[static_cast<K>(i * 3u + 2u)] == -1);
+    }
+    CHECK(lookup[K{}] == -1);
+}
+} // namespace
+
+TEST_CASE("a lookup with more entries than allowed", "[simd linear search]") {
+    constexpr auto lookup = lookup::simd_linear_search_lookup<2>::make(
+        CX_VALUE(lookup::input<int, int, 3>{
+            0, std::array{lookup::entry{1, 1}, lookup::entry{2, 2},
+                          lookup::entry{3, 3}}}));
+    static_assert(lookup::strategy_failed(lookup));
+}
+
+TEST_CASE("a lookup with no entries", "[simd linear search]") {
+    constexpr auto lookup = LS::make(CX_VALUE(lookup::input<int>{42}));
+    static_assert(lookup[0] == 42);
+    CHECK(lookup[0] == 42);
+}
+
+TEST_CASE("a lookup with some entries", "[simd linear search]") {
+    constexpr auto lookup =
+        LS::make(CX_VALUE(lookup::input<std::uint32_t, std::uint32_t, 2>{
+            11u, std::array{lookup::entry{1u, 17u}, lookup::entry{2u, 42u}}}));
+    static_assert(lookup[1u] == 17u);
+    static_assert(lookup[3u] == 11u);
+    CHECK(lookup[0u] == 11u);
+    CHECK(lookup[1u] == 17u);
+    CHECK(lookup[2u] == 42u);
+}
+
+TEST_CASE("a lookup with non-integer values", "[simd linear search]") {
+    constexpr auto lookup =
+        LS::make(CX_VALUE(lookup::input<std::uint32_t, float, 2>{
+            3.14f,
+            std::array{lookup::entry{1u, 17.0f}, lookup::entry{2u, 42.0f}}}));
+    CHECK(lookup[0u] == 3.14f);
+    CHECK(lookup[1u] == 17.0f);
+    CHECK(lookup[2u] == 42.0f);
+}
+
+TEST_CASE("lookups with each key width", "[simd linear search]") {
+    check_all<std::uint8_t, 20>();
+    check_all<std::uint16_t, 20>();
+    check_all<std::uint32_t, 20>();
+    check_all<std::uint64_t, 20>();
+    check_all<std::int32_t, 20>();
+}
+
+TEST_CASE("lookups with each table size", "[simd linear search]") {
+    check_all<std::uint32_t, 1>();
+    check_all<std::uint32_t, 7>();
+    check_all<std::uint32_t, 8>();
+    check_all<std::uint32_t, 9>();
+    check_all<std::uint32_t, 16>();
+    check_all<std::uint32_t, 33>();
+    check_all<std::uint32_t, 64>();
+}
+
+enum class some_key_t : std::uint16_t { ALPHA, BETA, KAPPA, GAMMA };
+
+TEST_CASE("a lookup with scoped enum entries", "[simd linear search]") {
+    constexpr auto lookup =
+        LS::make(CX_VALUE(lookup::input<some_key_t, std::int8_t, 3>{
+            0, std::array{
+                   lookup::entry<some_key_t, int8_t>{some_key_t::ALPHA, 54},
+                   lookup::entry<some_key_t, int8_t>{some_key_t::KAPPA, 87},
+                   lookup::entry<some_key_t, int8_t>{some_key_t::GAMMA, 4}}}));
+
+    CHECK(lookup[some_key_t::ALPHA] == 54);
+    CHECK(lookup[some_key_t::BETA] == 0);
+    CHECK(lookup[some_key_t::KAPPA] == 87);
+    CHECK(lookup[some_key_t::GAMMA] == 4);
+}
@@ -0,0 +1,169 @@
+#include <log/fmt/logger.hpp>
+#include <msg/buffer_chain.hpp>
+#include <msg/callback.hpp>
+#include <msg/field.hpp>
+#include <msg/handler.hpp>
+#include <msg/message.hpp>
+
+#include <stdx/panic.hpp>
+#include <stdx/tuple.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace {
+using namespace msg;
+
+using id_field = field<"id", std::uint32_t>::located<at{0_dw, 31_msb, 24_lsb}>;
+using field1 = field<"f1", std::uint32_t>::located<at{0_dw, 15_msb, 0_lsb}>;
+using field2 = field<"f2", std::uint32_t>::located<at{1_dw, 23_msb, 16_lsb}>;
+using field3 = field<"f3", std::uint32_t>::located<at{2_dw, 15_msb, 0_lsb}>;
+
+using msg_defn = message<"msg", id_field, field1, field2, field3>;
+
+// a one-dword header and a two-dword payload
+using chain_t = buffer_chain<std::uint32_t const, 1, 2>;
+using mutable_chain_t = buffer_chain<std::uint32_t, 1, 2>;
+
+bool dispatched = false;
+std::uint32_t dispatched_f3{};
+
+std::string log_buffer{};
+
+std::string panic_string = {};
+int panics{};
+
+struct test_panic_handler {
+    template <stdx::ct_string Why, typename... Ts>
+    static auto panic(Ts &&...) -> void {
+        panic_string = std::string_view{Why};
+        ++panics;
+    }
+};
+} // namespace
+
+template <> inline auto stdx::panic_handler<> = test_panic_handler{};
+
+template <>
+inline auto logging::config<> =
+    logging::fmt::config{std::back_inserter(log_buffer)};
+
+TEST_CASE("buffer chain indexes across segments", "[buffer_chain]") {
+    auto const header = std::array{0x8000'ba11u};
+    auto const payload = std::array{0x0042'0000u, 0x0000'd00du};
+    auto const c = chain_t{header, payload};
+
+    CHECK(c.size() == 3);
+    CHECK(c[0] == 0x8000'ba11u);
+    CHECK(c[2] == 0x0000'd00du);
+    CHECK(c.at<1>() == 0x0042'0000u);
+    static_assert(stdx::ct_capacity_v<chain_t> == 3);
+}
+
+TEST_CASE("buffer chain segment is resolved at compile time",
+          "[buffer_chain]") {
+    constexpr auto v = [] {
+        auto const header = std::array{1u};
+        auto const payload = std::array{2u, 3u};
+        return chain_t{header, payload}.at<2>();
+    }();
+    static_assert(v == 3u);
+}
+
+TEST_CASE("view fields over a buffer chain", "[buffer_chain]") {
+    auto const header = std::array{0x8000'ba11u};
+    auto const payload = std::array{0x0042'0000u, 0x0000'd00du};
+    auto const v = msg_defn::view_t{chain_t{header, payload}};
+    static_assert(std::is_same_v<decltype(v)::span_t, chain_t>);
+
+    CHECK(0x80 == v.get("id"_field));
+    CHECK(0xba11 == v.get("f1"_field));
+    CHECK(0x42 == v.get("f2"_field));
+    CHECK(0xd00d == v.get("f3"_field));
+}
+
+TEST_CASE("set fields through a mutable view over a buffer chain",
+          "[buffer_chain]") {
+    auto header = std::array{0u};
+    auto payload = std::array{0u, 0u};
+    auto c = mutable_chain_t{header, payload};
+    auto v = msg_defn::view_t{c};
+    v.set("id"_field = 0x80, "f2"_field = 0x42, "f3"_field = 0xd00d);
+
+    CHECK(header[0] == 0x8000'0000u);
+    CHECK(payload[0] == 0x0042'0000u);
+    CHECK(payload[1] == 0x0000'd00du);
+}
+
+TEST_CASE("view fields over a dynamic buffer chain", "[buffer_chain]") {
+    auto const raw = std::array{0x8000'ba11u, 0x0042'0000u, 0x0000'd00du};
+    for (auto split = std::size_t{}; split <= raw.size(); ++split) {
+        auto const c = dynamic_buffer_chain<std::uint32_t const, 3>{
+            stdx::span<std::uint32_t const>{raw.data(), split},
+            stdx::span<std::uint32_t const>{raw.data() + split,
+                                            raw.size() - split}};
+        auto const v = msg_defn::view_t{c};
+        CAPTURE(split);
+        CHECK(0x80 == v.get("id"_field));
+        CHECK(0xba11 == v.get("f1"_field));
+        CHECK(0x42 == v.get("f2"_field));
+        CHECK(0xd00d == v.get("f3"_field));
+    }
+}
+
+TEST_CASE("a dynamic buffer chain must cover its capacity", "[buffer_chain]") {
+    auto const raw = std::array{0x8000'ba11u, 0x0042'0000u, 0x0000'd00du};
+    using dynamic_chain_t = dynamic_buffer_chain<std::uint32_t const, 3>;
+
+    panics = 0;
+    [[maybe_unused]] auto const c = dynamic_chain_t{
+        stdx::span<std::uint32_t const>{raw.data(), 1},
+        stdx::span<std::uint32_t const>{raw.data() + 1, 1}};
+    CHECK(panics == 1);
+    CHECK(panic_string == "Buffer chain is shorter than its capacity");
+
+    // segments may cover more than the capacity
+    panics = 0;
+    auto const longer = dynamic_buffer_chain<std::uint32_t const, 2>{
+        stdx::span<std::uint32_t const>{raw.data(), 1},
+        stdx::span<std::uint32_t const>{raw.data() + 1, 2}};
+    CHECK(panics == 0);
+    CHECK(longer[1] == 0x0042'0000u);
+}
+
+TEST_CASE("owning message copied from a buffer chain", "[buffer_chain]") {
+    auto const header = std::array{0x8000'ba11u};
+    auto const payload = std::array{0x0042'0000u, 0x0000'd00du};
+    auto const m = msg_defn::owner_t{chain_t{header, payload}};
+
+    auto const data = m.data();
+    CHECK(data[0] == 0x8000'ba11u);
+    CHECK(data[1] == 0x0042'0000u);
+    CHECK(data[2] == 0x0000'd00du);
+}
+
+TEST_CASE("handler dispatches a buffer chain without copying",
+          "[buffer_chain]") {
+    auto callback = msg::callback<"cb", msg_defn>(
+        msg::equal_to<id_field, 0x80>,
+        [](msg_defn::view_t<chain_t> v) {
+            dispatched = true;
+            dispatched_f3 = v.get("f3"_field);
+        });
+    auto callbacks = stdx::make_tuple(callback);
+    auto handler = msg::handler<decltype(callbacks), chain_t>{callbacks};
+
+    auto const header = std::array{0x8000'ba11u};
+    auto const payload = std::array{0x0042'0000u, 0x0000'd00du};
+    dispatched = false;
+    dispatched_f3 = 0;
+    CHECK(handler.handle(chain_t{header, payload}));
+    CHECK(dispatched);
+    CHECK(dispatched_f3 == 0xd00d);
+}
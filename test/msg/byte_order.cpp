@@ -0,0 +1,115 @@
+#include <log/fmt/logger.hpp>
+#include <msg/callback.hpp>
+#include <msg/field.hpp>
+#include <msg/handler.hpp>
+#include <msg/message.hpp>
+
+#include <stdx/tuple.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+namespace {
+using namespace msg;
+
+using id_field = field<"id", std::uint32_t>::located<at{0_dw, 31_msb, 24_lsb}>;
+using field1 = field<"f1", std::uint32_t>::located<at{0_dw, 15_msb, 0_lsb}>;
+using field2 = field<"f2", std::uint32_t>::located<at{1_dw, 23_msb, 16_lsb}>;
+using field3 = field<"f3", std::uint32_t>::located<at{1_dw, 15_msb, 8_lsb},
+                                                   at{1_dw, 7_msb, 0_lsb}>;
+
+using msg_defn = message<"msg", big_endian, id_field::with_required<0x80>,
+                         field1, field2, field3>;
+
+// the bytes of 0x8000'ba11 and 0x0042'd00d, most significant first
+constexpr auto wire_bytes =
+    std::array<std::uint8_t, 8>{0x80, 0x00, 0xba, 0x11, 0x00, 0x42, 0xd0, 0x0d};
+
+auto wire_dwords() {
+    return std::bit_cast<std::array<std::uint32_t, 2>>(wire_bytes);
+}
+
+bool dispatched = false;
+
+std::string log_buffer{};
+} // namespace
+
+template <>
+inline auto logging::config<> =
+    logging::fmt::config{std::back_inserter(log_buffer)};
+
+TEST_CASE("messages are little-endian by default", "[byte_order]") {
+    using defn = message<"msg", field1>;
+    static_assert(get_byte_order(defn::env_t{}) == std::endian::little);
+    static_assert(get_byte_order(msg_defn::env_t{}) == std::endian::big);
+}
+
+TEST_CASE("get fields from big-endian dwords", "[byte_order]") {
+    auto const data = wire_dwords();
+    auto const v = msg_defn::view_t{data};
+    CHECK(0x80 == v.get("id"_field));
+    CHECK(0xba11 == v.get("f1"_field));
+    CHECK(0x42 == v.get("f2"_field));
+    CHECK(0xd00d == v.get("f3"_field));
+}
+
+TEST_CASE("get fields from big-endian bytes", "[byte_order]") {
+    auto const v = msg_defn::view_t{wire_bytes};
+    CHECK(0x80 == v.get("id"_field));
+    CHECK(0xba11 == v.get("f1"_field));
+    CHECK(0x42 == v.get("f2"_field));
+    CHECK(0xd00d == v.get("f3"_field));
+}
+
+TEST_CASE("set fields in big-endian storage", "[byte_order]") {
+    auto const m = owning<msg_defn>{"f1"_field = 0xba11, "f2"_field = 0x42,
+                                    "f3"_field = 0xd00d};
+    auto const data = m.data();
+    CHECK(data[0] == wire_dwords()[0]);
+    CHECK(data[1] == wire_dwords()[1]);
+}
+
+TEST_CASE("set fields in big-endian byte storage", "[byte_order]") {
+    using storage_t = msg_defn::custom_storage_t<std::array, std::uint8_t>;
+    auto const m = msg_defn::owner_t<storage_t>{
+        "f1"_field = 0xba11, "f2"_field = 0x42, "f3"_field = 0xd00d};
+    auto const data = m.data();
+    CHECK(std::equal(std::begin(wire_bytes), std::end(wire_bytes),
+                     std::begin(data), std::end(data)));
+}
+
+TEST_CASE("required field matches big-endian storage", "[byte_order]") {
+    auto data = wire_dwords();
+    CHECK(msg_defn::matcher_t{}(data));
+    data[0] = std::bit_cast<std::uint32_t>(
+        std::array<std::uint8_t, 4>{0x81, 0x00, 0xba, 0x11});
+    CHECK(not msg_defn::matcher_t{}(data));
+}
+
+TEST_CASE("with_env can make a message big-endian", "[byte_order]") {
+    using little_defn = message<"msg", field1, field2>;
+    using big_defn = little_defn::with_env<big_endian>;
+    auto const data = wire_dwords();
+    CHECK((data[0] & 0xffffu) == little_defn::view_t{data}.get("f1"_field));
+    CHECK(0xba11 == big_defn::view_t{data}.get("f1"_field));
+}
+
+TEST_CASE("handler matches big-endian raw data", "[byte_order]") {
+    auto callback = msg::callback<"cb", msg_defn>(
+        "f2"_field == constant<0x42>,
+        [](msg::const_view<msg_defn>) { dispatched = true; });
+    auto const data = wire_dwords();
+
+    auto callbacks = stdx::make_tuple(callback);
+    auto handler = msg::handler<decltype(callbacks), decltype(data)>{callbacks};
+    dispatched = false;
+    CHECK(handler.handle(data));
+    CHECK(dispatched);
+}
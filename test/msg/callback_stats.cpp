@@ -0,0 +1,144 @@
+#include <cib/cib.hpp>
+#include <match/ops.hpp>
+#include <msg/callback.hpp>
+#include <msg/callback_stats.hpp>
+#include <msg/decision_tree_service.hpp>
+#include <msg/field.hpp>
+#include <msg/handler.hpp>
+#include <msg/message.hpp>
+
+#include <stdx/tuple.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+using namespace msg;
+
+using id_field = field<"id", std::uint32_t>::located<at{0_dw, 31_msb, 24_lsb}>;
+using field1 = field<"f1", std::uint32_t>::located<at{0_dw, 15_msb, 0_lsb}>;
+
+using msg_defn = message<"msg", id_field, field1>;
+
+template <auto V> constexpr auto id_match = msg::equal_to_t<id_field, V>{};
+
+// the callables below advance the fake cycle count by 5 each call
+std::uint64_t fake_cycles{};
+struct test_stats_config {
+    static auto cycles() -> std::uint64_t { return fake_cycles; }
+};
+} // namespace
+
+template <> inline auto msg::stats::config<> = test_stats_config{};
+
+TEST_CASE("callback counts hits and mismatches", "[callback_stats]") {
+    auto callback = msg::callback<"count_cb", msg_defn>(
+        id_match<0x80>, [](msg::const_view<msg_defn>) { fake_cycles += 5; });
+    msg::stats::reset(callback);
+
+    CHECK(callback.handle(std::array{0x8000ba11u}));
+    CHECK(not callback.handle(std::array{0x8100ba11u}));
+    CHECK(callback.handle(std::array{0x8000ba11u}));
+
+    auto const s = msg::stats::read(callback);
+    CHECK(s.hits == 2);
+    CHECK(s.mismatches == 1);
+}
+
+TEST_CASE("callback records a histogram of call times", "[callback_stats]") {
+    auto callback = msg::callback<"timed_cb", msg_defn>(
+        id_match<0x80>, [](msg::const_view<msg_defn>) { fake_cycles += 5; });
+    msg::stats::reset(callback);
+
+    CHECK(callback.handle(std::array{0x8000ba11u}));
+    CHECK(callback.handle(std::array{0x8000ba11u}));
+
+    // 5 cycles is in [4, 8)
+    auto const s = msg::stats::read(callback);
+    CHECK(s.cycles[3] == 2);
+    CHECK(s.cycles[2] == 0);
+    CHECK(s.cycles[4] == 0);
+}
+
+TEST_CASE("handler records stats for each callback", "[callback_stats]") {
+    auto callback1 = msg::callback<"cb1", msg_defn>(
+        id_match<0x80>, [](msg::const_view<msg_defn>) {});
+    auto callback2 = msg::callback<"cb2", msg_defn>(
+        id_match<0x44>, [](msg::const_view<msg_defn>) {});
+    msg::stats::reset(callback1);
+    msg::stats::reset(callback2);
+
+    auto callbacks = stdx::make_tuple(callback1, callback2);
+    using msg_t = std::array<std::uint32_t, 1>;
+    auto handler = msg::handler<decltype(callbacks), msg_t>{callbacks};
+    CHECK(handler.handle(msg_t{0x4400ba11u}));
+    CHECK(handler.handle(msg_t{0x4400ba11u}));
+    CHECK(handler.handle(msg_t{0x8000ba11u}));
+
+    CHECK(msg::stats::read(callback1).hits == 1);
+    CHECK(msg::stats::read(callback1).mismatches == 2);
+    CHECK(msg::stats::read(callback2).hits == 2);
+    CHECK(msg::stats::read(callback2).mismatches == 1);
+}
+
+TEST_CASE("counters are 64 bits wide", "[callback_stats]") {
+    static_assert(
+        std::is_same_v<decltype(msg::stats::snapshot::hits), std::uint64_t>);
+    static_assert(std::is_same_v<decltype(msg::stats::snapshot::mismatches),
+                                 std::uint64_t>);
+}
+
+TEST_CASE("callbacks with the same name have their own counters",
+          "[callback_stats]") {
+    auto callback1 = msg::callback<"same_name", msg_defn>(
+        id_match<0x80>, [](msg::const_view<msg_defn>) {});
+    auto callback2 = msg::callback<"same_name", msg_defn>(
+        id_match<0x44>, [](msg::const_view<msg_defn>) {});
+    msg::stats::reset(callback1);
+    msg::stats::reset(callback2);
+
+    CHECK(callback1.handle(std::array{0x8000ba11u}));
+    CHECK(not callback2.handle(std::array{0x8000ba11u}));
+
+    CHECK(msg::stats::read(callback1).hits == 1);
+    CHECK(msg::stats::read(callback1).mismatches == 0);
+    CHECK(msg::stats::read(callback2).hits == 0);
+    CHECK(msg::stats::read(callback2).mismatches == 1);
+}
+
+namespace {
+// the tree decides id; f1 < 5 is left for the callback's residual matcher
+constexpr auto tree_callback = msg::callback<"tree_cb", msg_defn>(
+    id_match<0x80> and msg::less_than<field1, 5u>,
+    [](msg::const_view<msg_defn>) {});
+
+struct tree_service
+    : msg::decision_tree_service<msg::const_view<msg_defn>> {};
+struct tree_project {
+    constexpr static auto config = cib::config(
+        cib::exports<tree_service>, cib::extend<tree_service>(tree_callback));
+};
+} // namespace
+
+TEST_CASE("decision tree handler records hits and mismatches",
+          "[callback_stats]") {
+    cib::nexus<tree_project> test_nexus{};
+    test_nexus.init();
+    msg::stats::reset(tree_callback);
+
+    auto const handle = [](std::uint32_t id, std::uint32_t f1) {
+        return cib::service<tree_service>->handle(
+            msg::owning<msg_defn>{"id"_field = id, "f1"_field = f1});
+    };
+    CHECK(handle(0x80, 4));
+    CHECK(not handle(0x80, 7));
+    // not a candidate in the tree: its matcher is not checked
+    CHECK(not handle(0x81, 4));
+
+    auto const s = msg::stats::read(tree_callback);
+    CHECK(s.hits == 1);
+    CHECK(s.mismatches == 1);
+}
@@ -0,0 +1,129 @@
+#include <msg/columnar.hpp>
+#include <msg/field.hpp>
+#include <msg/message.hpp>
+
+#include <stdx/panic.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace {
+using namespace msg;
+
+using id_field = field<"id", std::uint32_t>::located<at{0_dw, 31_msb, 24_lsb}>;
+using small_field =
+    field<"small", std::uint8_t>::located<at{1_dw, 11_msb, 4_lsb}>;
+using split_field =
+    field<"split", std::uint32_t>::located<at{0_dw, 7_msb, 0_lsb},
+                                           at{1_dw, 31_msb, 24_lsb}>;
+
+using msg_defn = message<"msg", id_field, small_field, split_field>;
+using buffer_t = std::array<std::uint32_t, 2>;
+
+// more messages than one SIMD block, and a partial block
+constexpr auto num_msgs = std::size_t{21};
+
+auto make_buffers() {
+    std::array<buffer_t, num_msgs> msgs{};
+    for (auto i = std::size_t{}; i < num_msgs; ++i) {
+        auto const n = static_cast<std::uint32_t>(i);
+        msgs[i] = {0xa5000000u | (n << 24u) | n * 3u,
+                   0xf000000fu | (n * 5u) << 4u | (n << 24u)};
+    }
+    return msgs;
+}
+
+std::string panic_string = {};
+int panics{};
+
+struct test_panic_handler {
+    template <stdx::ct_string Why, typename... Ts>
+    static auto panic(Ts &&...) -> void {
+        panic_string = std::string_view{Why};
+        ++panics;
+    }
+};
+} // namespace
+
+template <> inline auto stdx::panic_handler<> = test_panic_handler{};
+
+TEST_CASE("extract a column of a field within one dword", "[columnar]") {
+    auto const msgs = make_buffers();
+    std::array<std::uint32_t, num_msgs> ids{};
+    std::array<std::uint8_t, num_msgs> smalls{};
+    extract_column<id_field>(std::span{msgs}, std::span{ids});
+    extract_column<small_field>(std::span{msgs}, std::span{smalls});
+    for (auto i = std::size_t{}; i < num_msgs; ++i) {
+        CHECK(ids[i] == id_field::extract(msgs[i]));
+        CHECK(smalls[i] == small_field::extract(msgs[i]));
+    }
+}
+
+TEST_CASE("extract a column of a field across dwords", "[columnar]") {
+    auto const msgs = make_buffers();
+    std::array<std::uint32_t, num_msgs> splits{};
+    extract_column<split_field>(std::span{msgs}, std::span{splits});
+    for (auto i = std::size_t{}; i < num_msgs; ++i) {
+        CHECK(splits[i] == split_field::extract(msgs[i]));
+    }
+}
+
+TEST_CASE("extract a column from owning messages", "[columnar]") {
+    std::array<owning<msg_defn>, 3> msgs{};
+    for (auto i = std::size_t{}; i < msgs.size(); ++i) {
+        msgs[i].set("id"_field = static_cast<std::uint32_t>(i + 1));
+    }
+    std::array<std::uint32_t, 3> ids{};
+    extract_column<id_field>(std::span{msgs}, std::span{ids});
+    CHECK(ids == std::array<std::uint32_t, 3>{1, 2, 3});
+}
+
+TEST_CASE("insert a column", "[columnar]") {
+    auto msgs = make_buffers();
+    auto const expected = [&] {
+        auto m = msgs;
+        for (auto i = std::size_t{}; i < num_msgs; ++i) {
+            small_field::insert(m[i], static_cast<std::uint8_t>(0xff - i));
+            split_field::insert(m[i], static_cast<std::uint32_t>(i * 1000));
+        }
+        return m;
+    }();
+
+    std::array<std::uint8_t, num_msgs> smalls{};
+    std::array<std::uint32_t, num_msgs> splits{};
+    for (auto i = std::size_t{}; i < num_msgs; ++i) {
+        smalls[i] = static_cast<std::uint8_t>(0xff - i);
+        splits[i] = static_cast<std::uint32_t>(i * 1000);
+    }
+    insert_column<small_field>(std::span{msgs},
+                               std::span<std::uint8_t const>{smalls});
+    insert_column<split_field>(std::span{msgs},
+                               std::span<std::uint32_t const>{splits});
+    CHECK(msgs == expected);
+}
+
+TEST_CASE("a column with too few values panics", "[columnar]") {
+    panics = 0;
+    auto msgs = make_buffers();
+    std::array<std::uint32_t, num_msgs> ids{};
+    extract_column<id_field>(std::span{msgs},
+                             std::span<std::uint32_t>{ids.data(), 9});
+    CHECK(panics == 1);
+    CHECK(panic_string == "Column has fewer values than messages");
+    for (auto i = std::size_t{}; i < 9; ++i) {
+        CHECK(ids[i] == id_field::extract(msgs[i]));
+    }
+    CHECK(ids[9] == 0);
+
+    auto const expected = msgs[3];
+    insert_column<small_field>(std::span{msgs},
+                               std::span<std::uint8_t const>{});
+    CHECK(panics == 2);
+    CHECK(msgs[3] == expected);
+}
@@ -0,0 +1,200 @@
+#include <cib/cib.hpp>
+#include <log/fmt/logger.hpp>
+#include <match/ops.hpp>
+#include <msg/callback.hpp>
+#include <msg/decision_tree_service.hpp>
+#include <msg/field.hpp>
+#include <msg/message.hpp>
+#include <msg/service.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace msg;
+
+using id_field = field<"id", std::uint32_t>::located<at{0_dw, 31_msb, 24_lsb}>;
+using field1 = field<"f1", std::uint32_t>::located<at{0_dw, 15_msb, 0_lsb}>;
+using field2 = field<"f2", std::uint32_t>::located<at{1_dw, 23_msb, 16_lsb}>;
+using field3 = field<"f3", std::uint32_t>::located<at{1_dw, 15_msb, 0_lsb}>;
+
+using msg_defn = message<"msg", id_field, field1, field2, field3>;
+using test_msg_t = msg::owning<msg_defn>;
+using msg_view_t = msg::const_view<msg_defn>;
+
+constexpr auto id_match = msg::equal_to<id_field, 0x80>;
+
+bool callback_success;
+
+constexpr auto test_callback = msg::callback<"cb", msg_defn>(
+    id_match, [](msg_view_t) { callback_success = true; });
+
+struct test_service : msg::decision_tree_service<msg_view_t> {};
+struct test_project {
+    constexpr static auto config = cib::config(
+        cib::exports<test_service>, cib::extend<test_service>(test_callback));
+};
+
+std::string log_buffer{};
+} // namespace
+
+template <>
+inline auto logging::config<> =
+    logging::fmt::config{std::back_inserter(log_buffer)};
+
+TEST_CASE("build handler", "[decision_tree_builder]") {
+    cib::nexus<test_project> test_nexus{};
+    test_nexus.init();
+
+    callback_success = false;
+    CHECK(cib::service<test_service>->handle(test_msg_t{"id"_field = 0x80}));
+    CHECK(callback_success);
+}
+
+TEST_CASE("build handler (no match)", "[decision_tree_builder]") {
+    cib::nexus<test_project> test_nexus{};
+    test_nexus.init();
+
+    callback_success = false;
+    CHECK(not cib::service<test_service>->handle(
+        test_msg_t{"id"_field = 0x70}));
+    CHECK(not callback_success);
+}
+
+TEST_CASE("match output failure", "[decision_tree_builder]") {
+    log_buffer.clear();
+    cib::nexus<test_project> test_nexus{};
+    test_nexus.init();
+
+    cib::service<test_service>->handle(test_msg_t{"id"_field = 0x81});
+
+    CAPTURE(log_buffer);
+    CHECK(log_buffer.find(
+              "None of the registered callbacks (1) claimed this message") !=
+          std::string::npos);
+    CHECK(log_buffer.find("id (0x81) == 0x80") != std::string::npos);
+}
+
+namespace {
+int callback_extra_arg{};
+
+constexpr auto test_callback_extra_args =
+    msg::callback<"cb", msg_defn>(id_match, [](msg_view_t, int i) {
+        callback_success = true;
+        callback_extra_arg = i;
+    });
+
+struct test_service_extra_args
+    : msg::decision_tree_service<msg_view_t, int> {};
+struct test_project_extra_args {
+    constexpr static auto config = cib::config(
+        cib::exports<test_service_extra_args>,
+        cib::extend<test_service_extra_args>(test_callback_extra_args));
+};
+} // namespace
+
+TEST_CASE("handle extra arguments", "[decision_tree_builder]") {
+    cib::nexus<test_project_extra_args> test_nexus{};
+    test_nexus.init();
+
+    callback_success = false;
+    cib::service<test_service_extra_args>->handle(test_msg_t{"id"_field = 0x80},
+                                                  42);
+    CHECK(callback_success);
+    CHECK(callback_extra_arg == 42);
+}
+
+namespace {
+// every callback bumps its own counter; the same callbacks go into a plain
+// service and a decision tree service, and both must call the same callbacks
+std::array<int, 6> counts{};
+
+template <std::size_t I> constexpr auto count = [](msg_view_t) { ++counts[I]; };
+
+constexpr auto callbacks = stdx::make_tuple(
+    msg::callback<"eq", msg_defn>(id_match and msg::equal_to<field1, 1>,
+                                  count<0>),
+    msg::callback<"or", msg_defn>(
+        msg::equal_to<field1, 1> or msg::equal_to<field2, 2>, count<1>),
+    msg::callback<"not", msg_defn>(
+        id_match and not msg::equal_to<field2, 2>, count<2>),
+    msg::callback<"in", msg_defn>(msg::in<field3, 3, 4, 5>, count<3>),
+    msg::callback<"range", msg_defn>(
+        msg::greater_than<field3, 3> and msg::equal_to<field1, 2>, count<4>),
+    msg::callback<"wild", msg_defn>(match::always, count<5>));
+
+struct plain_service : msg::service<msg_view_t> {};
+struct tree_service : msg::decision_tree_service<msg_view_t> {};
+
+struct equivalence_project {
+    constexpr static auto config = callbacks.apply([](auto... cbs) {
+        return cib::config(cib::exports<plain_service, tree_service>,
+                           cib::extend<plain_service>(cbs...),
+                           cib::extend<tree_service>(cbs...));
+    });
+};
+} // namespace
+
+TEST_CASE("decision tree calls the same callbacks as the plain handler",
+          "[decision_tree_builder]") {
+    cib::nexus<equivalence_project> test_nexus{};
+    test_nexus.init();
+
+    for (auto id : {0x70u, 0x80u}) {
+        for (auto f1 : {0u, 1u, 2u}) {
+            for (auto f2 : {0u, 2u}) {
+                for (auto f3 : {0u, 3u, 4u, 6u}) {
+                    auto const m = test_msg_t{"id"_field = id, "f1"_field = f1,
+                                              "f2"_field = f2, "f3"_field = f3};
+                    counts = {};
+                    auto const plain_handled =
+                        cib::service<plain_service>->handle(m);
+                    auto const expected = counts;
+
+                    counts = {};
+                    CHECK(cib::service<tree_service>->handle(m) ==
+                          plain_handled);
+                    CHECK(counts == expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("decision tree handles a batch like the plain handler",
+          "[decision_tree_builder]") {
+    cib::nexus<equivalence_project> test_nexus{};
+    test_nexus.init();
+
+    // more messages than fit in one chunk
+    auto msgs = std::vector<test_msg_t>{};
+    for (auto rep = 0; rep < 2; ++rep) {
+        for (auto id : {0x70u, 0x80u}) {
+            for (auto f1 : {0u, 1u, 2u}) {
+                for (auto f2 : {0u, 2u}) {
+                    for (auto f3 : {0u, 3u, 4u, 6u}) {
+                        msgs.push_back(
+                            test_msg_t{"id"_field = id, "f1"_field = f1,
+                                       "f2"_field = f2, "f3"_field = f3});
+                    }
+                }
+            }
+        }
+    }
+    auto const views =
+        std::vector<msg_view_t>(std::cbegin(msgs), std::cend(msgs));
+
+    counts = {};
+    auto const plain_handled =
+        cib::service<plain_service>->handle_batch(views);
+    auto const expected = counts;
+
+    counts = {};
+    CHECK(cib::service<tree_service>->handle_batch(views) == plain_handled);
+    CHECK(counts == expected);
+}
@@ -0,0 +1,53 @@
+#include <cib/cib.hpp>
+#include <msg/callback.hpp>
+#include <msg/decision_tree_service.hpp>
+#include <msg/field.hpp>
+#include <msg/message.hpp>
+
+#include <cstdint>
+
+// EXPECT: The decision tree for these callbacks is too large
+namespace {
+using namespace msg;
+
+// each callback constrains a different field, so each is in both branches on
+// every other field: the tree has 2^12 leaves
+using f0 = field<"f0", std::uint32_t>::located<at{0_dw, 1_msb, 0_lsb}>;
+using f1 = field<"f1", std::uint32_t>::located<at{0_dw, 3_msb, 2_lsb}>;
+using f2 = field<"f2", std::uint32_t>::located<at{0_dw, 5_msb, 4_lsb}>;
+using f3 = field<"f3", std::uint32_t>::located<at{0_dw, 7_msb, 6_lsb}>;
+using f4 = field<"f4", std::uint32_t>::located<at{0_dw, 9_msb, 8_lsb}>;
+using f5 = field<"f5", std::uint32_t>::located<at{0_dw, 11_msb, 10_lsb}>;
+using f6 = field<"f6", std::uint32_t>::located<at{0_dw, 13_msb, 12_lsb}>;
+using f7 = field<"f7", std::uint32_t>::located<at{0_dw, 15_msb, 14_lsb}>;
+using f8 = field<"f8", std::uint32_t>::located<at{0_dw, 17_msb, 16_lsb}>;
+using f9 = field<"f9", std::uint32_t>::located<at{0_dw, 19_msb, 18_lsb}>;
+using f10 = field<"f10", std::uint32_t>::located<at{0_dw, 21_msb, 20_lsb}>;
+using f11 = field<"f11", std::uint32_t>::located<at{0_dw, 23_msb, 22_lsb}>;
+
+using msg_defn =
+    message<"msg", f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11>;
+using msg_view_t = const_view<msg_defn>;
+
+template <typename F>
+constexpr auto test_callback =
+    msg::callback<"cb", msg_defn>(msg::equal_to<F, 1>, [](auto) {});
+
+struct test_service : msg::decision_tree_service<msg_view_t> {};
+
+struct test_project {
+    constexpr static auto config =
+        cib::config(cib::exports<test_service>,
+                    cib::extend<test_service>(
+                        test_callback<f0>, test_callback<f1>, test_callback<f2>,
+                        test_callback<f3>, test_callback<f4>, test_callback<f5>,
+                        test_callback<f6>, test_callback<f7>, test_callback<f8>,
+                        test_callback<f9>, test_callback<f10>,
+                        test_callback<f11>));
+};
+} // namespace
+
+int main() {
+    cib::nexus<test_project> test_nexus{};
+    test_nexus.init();
+}
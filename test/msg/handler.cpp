@@ -169,3 +169,28 @@ TEST_CASE("dispatch with extra args", "[handler]") {
     CHECK(handler.handle(msg, 0xcafe));
     CHECK(dispatched);
 }
+
+TEST_CASE("handle a batch of messages", "[handler]") {
+    int count1{};
+    int count2{};
+
+    auto callback1 = msg::callback<"cb1", msg_defn>(
+        id_match<0x80>, [&](msg::const_view<msg_defn>) { ++count1; });
+    auto callback2 = msg::callback<"cb2", msg_defn>(
+        id_match<0x44>, [&](msg::const_view<msg_defn>) { ++count2; });
+    using msg_t = std::array<std::uint32_t, 2>;
+    auto const msgs = std::array{
+        msg_t{0x8000ba11u, 0x0042d00du}, msg_t{0x4400ba11u, 0x0042d00du},
+        msg_t{0x8100ba11u, 0x0042d00du}, msg_t{0x8000ba11u, 0x0042d00du}};
+
+    auto callbacks = stdx::make_tuple(callback1, callback2);
+    static auto handler = msg::handler<decltype(callbacks), msg_t>{callbacks};
+
+    log_buffer.clear();
+    CHECK(handler.handle_batch(msgs) == 3);
+    CHECK(count1 == 2);
+    CHECK(count2 == 1);
+    CHECK(log_buffer.find(
+              "None of the registered callbacks (2) claimed this message") !=
+          std::string::npos);
+}
@@ -0,0 +1,46 @@
+#include <log/fmt/logger.hpp>
+#include <msg/callback.hpp>
+#include <msg/field.hpp>
+#include <msg/handler.hpp>
+#include <msg/message.hpp>
+
+#include <stdx/tuple.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string>
+
+namespace {
+using namespace msg;
+
+using id_field = field<"id", std::uint32_t>::located<at{0_dw, 31_msb, 24_lsb}>;
+using msg_defn = message<"msg", id_field>;
+
+std::string log_buffer{};
+} // namespace
+
+template <>
+inline auto logging::config<> =
+    logging::fmt::config{std::back_inserter(log_buffer)};
+
+template <> constexpr inline auto msg::describe_mismatches<> = false;
+
+TEST_CASE("mismatch descriptions can be left out", "[handler_quiet]") {
+    auto callback = msg::callback<"quiet_cb", msg_defn>(
+        msg::equal_to<id_field, 0x80>, [](msg::const_view<msg_defn>) {});
+    auto const msg = std::array{0x8100ba11u};
+
+    auto callbacks = stdx::make_tuple(callback);
+    auto handler = msg::handler<decltype(callbacks), decltype(msg)>{callbacks};
+
+    log_buffer.clear();
+    CHECK(not handler.handle(msg));
+    CAPTURE(log_buffer);
+    CHECK(log_buffer.find(
+              "None of the registered callbacks (1) claimed this message") !=
+          std::string::npos);
+    CHECK(log_buffer.find("quiet_cb") == std::string::npos);
+}
@@ -8,9 +8,12 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <string>
+#include <utility>
 
 namespace {
 using namespace msg;
@@ -521,3 +524,255 @@ TEST_CASE("call multiple callbacks", "[handler_builder]") {
     CHECK(callback_success);
     CHECK(callback2_success);
 }
+
+namespace {
+struct auto_indexed_service
+    : indexed_service<msg::auto_index_spec<>, test_msg_t> {};
+
+std::array<bool, 3> auto_callback_success{};
+
+template <std::size_t I>
+constexpr auto auto_callback = [](auto) { auto_callback_success[I] = true; };
+
+struct auto_index_project {
+    constexpr static auto config = cib::config(
+        cib::exports<auto_indexed_service>,
+        cib::extend<auto_indexed_service>(
+            msg::callback<"a", msg_defn>(
+                msg::equal_to<test_id_field, 0x80> and
+                    msg::equal_to<test_opcode_field, 1>,
+                auto_callback<0>),
+            msg::callback<"b", msg_defn>(
+                msg::equal_to<test_id_field, 0x81> and
+                    msg::equal_to<test_opcode_field, 1>,
+                auto_callback<1>),
+            msg::callback<"c", msg_defn>(
+                not msg::equal_to<test_opcode_field, 1>, auto_callback<2>)));
+};
+} // namespace
+
+TEST_CASE("auto index spec chooses fields to index", "[indexed_builder]") {
+    cib::nexus<auto_index_project> test_nexus{};
+    test_nexus.init();
+
+    log_buffer.clear();
+    auto_callback_success = {};
+    CHECK(cib::service<auto_indexed_service>->handle(test_msg_t{
+        "test_id_field"_field = 0x81, "test_opcode_field"_field = 1}));
+    CHECK(auto_callback_success == std::array{false, true, false});
+    CAPTURE(log_buffer);
+    CHECK(log_buffer.find("(collapsed by index from") != std::string::npos);
+
+    auto_callback_success = {};
+    CHECK(cib::service<auto_indexed_service>->handle(test_msg_t{
+        "test_id_field"_field = 0x80, "test_opcode_field"_field = 2}));
+    CHECK(auto_callback_success == std::array{false, false, true});
+
+    auto_callback_success = {};
+    CHECK(not cib::service<auto_indexed_service>->handle(test_msg_t{
+        "test_id_field"_field = 0x82, "test_opcode_field"_field = 1}));
+    CHECK(auto_callback_success == std::array{false, false, false});
+}
+
+namespace {
+struct auto_index_fallback_project {
+    constexpr static auto config =
+        cib::config(cib::exports<auto_indexed_service>,
+                    cib::extend<auto_indexed_service>(test_callback));
+};
+} // namespace
+
+TEST_CASE("auto index spec falls back to matching each callback",
+          "[indexed_builder]") {
+    cib::nexus<auto_index_fallback_project> test_nexus{};
+    test_nexus.init();
+
+    callback_success = false;
+    CHECK(cib::service<auto_indexed_service>->handle(
+        test_msg_t{"test_id_field"_field = 0x80}));
+    CHECK(callback_success);
+
+    log_buffer.clear();
+    callback_success = false;
+    CHECK(not cib::service<auto_indexed_service>->handle(
+        test_msg_t{"test_id_field"_field = 0x81}));
+    CHECK(not callback_success);
+    CAPTURE(log_buffer);
+    CHECK(log_buffer.find("None of the registered callbacks (1) claimed this "
+                          "message") != std::string::npos);
+}
+
+namespace {
+std::array<bool, 3> range_callback_success{};
+
+template <std::size_t I>
+constexpr auto range_callback = [](auto) { range_callback_success[I] = true; };
+
+struct range_project {
+    constexpr static auto config = cib::config(
+        cib::exports<test_service>,
+        cib::extend<test_service>(
+            msg::callback<"low", msg_defn>(
+                msg::less_than<test_opcode_field, 0x10>, range_callback<0>),
+            msg::callback<"mid", msg_defn>(
+                msg::greater_than_or_equal_to<test_opcode_field, 0x10> and
+                    msg::less_than_or_equal_to<test_opcode_field, 0x20>,
+                range_callback<1>),
+            msg::callback<"high", msg_defn>(
+                msg::greater_than<test_opcode_field, 0x20> and
+                    msg::equal_to<test_id_field, 0x80>,
+                range_callback<2>)));
+};
+} // namespace
+
+TEST_CASE("build handler range terms", "[indexed_builder]") {
+    cib::nexus<range_project> test_nexus{};
+    test_nexus.init();
+
+    auto const handle = [](std::uint32_t id, std::uint32_t opcode) {
+        range_callback_success = {};
+        return cib::service<test_service>->handle(test_msg_t{
+            "test_id_field"_field = id, "test_opcode_field"_field = opcode});
+    };
+
+    CHECK(handle(0x80, 0));
+    CHECK(range_callback_success == std::array{true, false, false});
+    CHECK(handle(0x80, 0xf));
+    CHECK(range_callback_success == std::array{true, false, false});
+
+    log_buffer.clear();
+    CHECK(handle(0x80, 0x10));
+    CHECK(range_callback_success == std::array{false, true, false});
+    // the range terms were decided by the index
+    CAPTURE(log_buffer);
+    CHECK(log_buffer.find("because [true]") != std::string::npos);
+
+    CHECK(handle(0x80, 0x20));
+    CHECK(range_callback_success == std::array{false, true, false});
+    CHECK(handle(0x80, 0x21));
+    CHECK(range_callback_success == std::array{false, false, true});
+    CHECK(handle(0x80, 0xffff));
+    CHECK(range_callback_success == std::array{false, false, true});
+
+    CHECK(not handle(0x81, 0x21));
+    CHECK(range_callback_success == std::array{false, false, false});
+}
+
+namespace {
+using byte_field =
+    field<"byte_field", std::uint8_t>::located<at{1_dw, 7_msb, 0_lsb}>;
+using byte_msg_defn = message<"byte_msg", test_id_field, byte_field>;
+using byte_msg_t = owning<byte_msg_defn>;
+
+struct byte_service
+    : indexed_service<msg::index_spec<byte_field>, byte_msg_t> {};
+
+template <std::size_t I>
+constexpr auto byte_callback = [](auto) { range_callback_success[I] = true; };
+
+// bounds outside the range of the field: truncated to std::uint8_t they would
+// be < 44, >= 44 and > 255
+struct out_of_range_project {
+    constexpr static auto config = cib::config(
+        cib::exports<byte_service>,
+        cib::extend<byte_service>(
+            msg::callback<"below", byte_msg_defn>(
+                msg::less_than<byte_field, 300>, byte_callback<0>),
+            msg::callback<"above", byte_msg_defn>(
+                msg::greater_than_or_equal_to<byte_field, 300>,
+                byte_callback<1>),
+            msg::callback<"any", byte_msg_defn>(
+                msg::greater_than<byte_field, -1>, byte_callback<2>)));
+};
+} // namespace
+
+TEST_CASE("range terms with bounds outside the field's range",
+          "[indexed_builder]") {
+    cib::nexus<out_of_range_project> test_nexus{};
+    test_nexus.init();
+
+    for (auto b : {0, 43, 44, 0xff}) {
+        CAPTURE(b);
+        range_callback_success = {};
+        CHECK(cib::service<byte_service>->handle(
+            byte_msg_t{"byte_field"_field = static_cast<std::uint8_t>(b)}));
+        CHECK(range_callback_success == std::array{true, false, true});
+    }
+}
+
+namespace {
+constexpr auto num_many_callbacks = std::size_t{260};
+std::array<bool, num_many_callbacks> many_callback_success{};
+
+template <std::size_t I>
+constexpr auto many_callback = msg::callback<"many", msg_defn>(
+    msg::equal_to<test_opcode_field, static_cast<std::uint32_t>(I)>,
+    [](auto) { many_callback_success[I] = true; });
+
+struct many_callbacks_project {
+    constexpr static auto config =
+        []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return cib::config(cib::exports<test_service>,
+                               cib::extend<test_service>(many_callback<Is>...));
+        }(std::make_index_sequence<num_many_callbacks>{});
+};
+} // namespace
+
+TEST_CASE("index capacities scale with the callbacks", "[indexed_builder]") {
+    cib::nexus<many_callbacks_project> test_nexus{};
+    test_nexus.init();
+
+    for (auto i : {std::size_t{}, std::size_t{255}, num_many_callbacks - 1}) {
+        many_callback_success = {};
+        CHECK(cib::service<test_service>->handle(
+            test_msg_t{"test_opcode_field"_field =
+                           static_cast<std::uint32_t>(i)}));
+        CHECK(many_callback_success[i]);
+    }
+}
+
+namespace {
+// the residual matchers (what the index on test_id_field leaves) share
+// test_field_2, so the handler extracts it once per message
+bool low_callback_success;
+bool high_callback_success;
+
+constexpr auto low_callback = msg::callback<"low_callback", msg_defn>(
+    msg::equal_to<test_id_field, 0x80> and
+        msg::less_than<test_field_2, 5u>,
+    [](auto) { low_callback_success = true; });
+
+constexpr auto high_callback = msg::callback<"high_callback", msg_defn>(
+    msg::equal_to<test_id_field, 0x80> and
+        msg::greater_than_or_equal_to<test_field_2, 5u> and
+        msg::equal_to<test_field_3, 7u>,
+    [](auto) { high_callback_success = true; });
+
+struct shared_residual_project {
+    constexpr static auto config =
+        cib::config(cib::exports<partially_indexed_test_service>,
+                    cib::extend<partially_indexed_test_service>(
+                        low_callback, high_callback));
+};
+} // namespace
+
+TEST_CASE("residual matchers share extracted fields", "[indexed_builder]") {
+    cib::nexus<shared_residual_project> test_nexus{};
+    test_nexus.init();
+
+    auto const check = [](std::uint32_t f2, std::uint32_t f3, bool low,
+                          bool high) {
+        low_callback_success = false;
+        high_callback_success = false;
+        CHECK(cib::service<partially_indexed_test_service>->handle(test_msg_t{
+                  "test_id_field"_field = 0x80, "test_field_2"_field = f2,
+                  "test_field_3"_field = f3}) == (low or high));
+        CHECK(low_callback_success == low);
+        CHECK(high_callback_success == high);
+    };
+
+    check(4, 7, true, false);
+    check(5, 7, false, true);
+    check(5, 6, false, false);
+    check(0, 0, true, false);
+}
@@ -1,11 +1,13 @@
 #include <lookup/input.hpp>
 #include <lookup/lookup.hpp>
 #include <msg/callback.hpp>
+#include <msg/detail/field_cache.hpp>
 #include <msg/field.hpp>
 #include <msg/indexed_handler.hpp>
 #include <msg/message.hpp>
 
 #include <stdx/bitset.hpp>
+#include <stdx/type_traits.hpp>
 #include <stdx/utility.hpp>
 
 #include <catch2/catch_test_macros.hpp>
@@ -13,6 +15,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 namespace {
 using namespace msg;
@@ -36,6 +39,7 @@ using callback_t = auto (*)(test_msg const &) -> bool;
 template <auto N> using bitset = stdx::bitset<N, std::uint32_t>;
 
 bitset<32> callbacks_called{};
+int batch_count{};
 } // namespace
 
 TEST_CASE("create empty handler", "[indexed_handler]") {
@@ -167,6 +171,117 @@ TEST_CASE("create handler with multiple indices and callbacks",
     check_no_match(1, 4);
 }
 
+TEST_CASE("handle a batch of messages", "[indexed_handler]") {
+    using lookup::entry;
+
+    constexpr auto h = msg::make_indexed_handler<test_msg>(
+        msg::indices{
+            msg::index{
+                opcode_field{},
+                lookup::make(
+                    CX_VALUE(lookup::input<std::uint32_t, bitset<32>, 2>{
+                        bitset<32>{},
+                        std::array{entry{0u, bitset<32>{stdx::place_bits, 0}},
+                                   entry{1u, bitset<32>{stdx::place_bits, 1,
+                                                        2}}}}))},
+            msg::index{
+                sub_opcode_field{},
+                lookup::make(
+                    CX_VALUE(lookup::input<std::uint32_t, bitset<32>, 2>{
+                        bitset<32>{stdx::place_bits, 0},
+                        std::array{
+                            entry{0u, bitset<32>{stdx::place_bits, 0, 1}},
+                            entry{1u, bitset<32>{stdx::place_bits, 0, 2}},
+                        }}))}},
+        std::array<callback_t, 3>{[](test_msg const &) {
+                                      callbacks_called.set(0);
+                                      return true;
+                                  },
+                                  [](test_msg const &) {
+                                      callbacks_called.set(1);
+                                      return true;
+                                  },
+                                  [](test_msg const &) {
+                                      callbacks_called.set(2);
+                                      return true;
+                                  }});
+
+    auto const msgs = std::array{
+        test_msg{"opcode_field"_field = 0, "sub_opcode_field"_field = 5},
+        test_msg{"opcode_field"_field = 1, "sub_opcode_field"_field = 0},
+        test_msg{"opcode_field"_field = 2, "sub_opcode_field"_field = 0},
+        test_msg{"opcode_field"_field = 1, "sub_opcode_field"_field = 1}};
+
+    callbacks_called.reset();
+    CHECK(h.handle_batch(msgs) == 3);
+    CHECK(callbacks_called == bitset<32>{stdx::place_bits, 0, 1, 2});
+}
+
+TEST_CASE("handle a batch larger than a chunk", "[indexed_handler]") {
+    constexpr auto h = msg::make_indexed_handler<test_msg>(
+        msg::indices{msg::index{
+            opcode_field{},
+            lookup::make(CX_VALUE(lookup::input<std::uint32_t, bitset<32>, 1>{
+                bitset<32>{}, std::array{lookup::entry{
+                                  42u, bitset<32>{stdx::place_bits, 0}}}}))}},
+        std::array<callback_t, 1>{[](test_msg const &) {
+            ++batch_count;
+            return true;
+        }});
+
+    std::array<test_msg, 150> msgs{};
+    for (auto i = std::size_t{}; i < msgs.size(); ++i) {
+        msgs[i].set("opcode_field"_field = i % 3 == 0 ? 42u : 0u);
+    }
+
+    batch_count = 0;
+    CHECK(h.handle_batch(msgs) == 50);
+    CHECK(batch_count == 50);
+}
+
+namespace {
+// field2, counting how many times it is extracted
+int field2_extractions{};
+struct counted_field2 : field2 {
+    template <typename R> static auto extract(R &&r) {
+        ++field2_extractions;
+        return field2::extract(std::forward<R>(r));
+    }
+};
+
+using cache_t =
+    msg::detail::field_cache<test_msg, stdx::type_list<counted_field2>>;
+using cached_callback_t = auto (*)(cache_t const &) -> bool;
+} // namespace
+
+TEST_CASE("batch callbacks share one field cache per message",
+          "[indexed_handler]") {
+    constexpr auto h = msg::make_indexed_handler<test_msg>(
+        msg::indices{msg::index{
+            opcode_field{},
+            lookup::make(CX_VALUE(lookup::input<std::uint32_t, bitset<32>, 1>{
+                bitset<32>{},
+                std::array{lookup::entry{
+                    42u, bitset<32>{stdx::place_bits, 0, 1}}}}))}},
+        std::array<cached_callback_t, 2>{
+            [](cache_t const &c) { return c.get<counted_field2>() < 5; },
+            [](cache_t const &c) { return c.get<counted_field2>() >= 5; }});
+
+    auto const msgs = std::array{
+        test_msg{"opcode_field"_field = 42, "f2"_field = 1},
+        test_msg{"opcode_field"_field = 42, "f2"_field = 7},
+        test_msg{"opcode_field"_field = 0, "f2"_field = 7},
+        test_msg{"opcode_field"_field = 42, "f2"_field = 5}};
+
+    field2_extractions = 0;
+    CHECK(h.handle_batch(msgs) == 3);
+    CHECK(field2_extractions == 3);
+
+    field2_extractions = 0;
+    CHECK(h.handle(msgs[0]));
+    CHECK(field2_extractions == 1);
+}
+
 TEST_CASE("create handler with extra callback arg", "[indexed_handler]") {
     constexpr auto h = msg::make_indexed_handler<test_msg, std::size_t>(
         msg::indices{msg::index{
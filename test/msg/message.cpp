@@ -405,6 +405,41 @@ TEST_CASE("construct with 8-bit storage", "[message]") {
                      std::end(data)));
 }
 
+TEST_CASE("get several fields at once", "[message]") {
+    test_msg msg{"f1"_field = 0xba11, "f2"_field = 0x42, "f3"_field = 0xd00d};
+
+    auto const fs = msg.get("id"_field, "f1"_field, "f2"_field, "f3"_field);
+    CHECK(0x80 == stdx::get<0>(fs));
+    CHECK(0xba11 == stdx::get<1>(fs));
+    CHECK(0x42 == stdx::get<2>(fs));
+    CHECK(0xd00d == stdx::get<3>(fs));
+}
+
+TEST_CASE("get several fields at once (8-bit storage)", "[message]") {
+    test_uint8_msg msg{"f1"_field = 0xba11, "f2"_field = 0x42,
+                       "f3"_field = 0xd00d};
+
+    auto const fs = msg.get("f3"_field, "id"_field, "f1"_field);
+    CHECK(0xd00d == stdx::get<0>(fs));
+    CHECK(0x80 == stdx::get<1>(fs));
+    CHECK(0xba11 == stdx::get<2>(fs));
+}
+
+TEST_CASE("set several fields sharing a dword", "[message]") {
+    test_msg msg{};
+    msg.set("f1"_field = 0xba11, "f2"_field = 0x42, "f3"_field = 0xd00d);
+
+    auto const data = msg.data();
+    CHECK(0x8000'ba11 == data[0]);
+    CHECK(0x0042'd00d == data[1]);
+}
+
+TEST_CASE("set the same field twice", "[message]") {
+    test_msg msg{};
+    msg.set("f1"_field = 0xba11, "f1"_field = 0xd00d);
+    CHECK(0xd00d == msg.get("f1"_field));
+}
+
 TEST_CASE("view with external custom storage (oversized)", "[message]") {
     auto const arr = std::array<std::uint8_t, 32>{0x00, 0xba, 0x11, 0x80,
                                                   0x00, 0x42, 0xd0, 0x0d};
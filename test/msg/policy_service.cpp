@@ -0,0 +1,174 @@
+#include <cib/cib.hpp>
+#include <log/fmt/logger.hpp>
+#include <match/ops.hpp>
+#include <msg/callback.hpp>
+#include <msg/field.hpp>
+#include <msg/message.hpp>
+#include <msg/policy_service.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+
+namespace {
+using namespace msg;
+
+using id_field = field<"id", std::uint32_t>::located<at{0_dw, 31_msb, 24_lsb}>;
+using opcode_field =
+    field<"opcode", std::uint32_t>::located<at{0_dw, 15_msb, 0_lsb}>;
+
+using msg_defn = message<"msg", id_field, opcode_field>;
+using test_msg_t = msg::owning<msg_defn>;
+using msg_view_t = msg::const_view<msg_defn>;
+
+std::array<int, 3> calls{};
+
+template <std::size_t I> constexpr auto count = [](auto) { ++calls[I]; };
+
+// all three match id 0x80; the last also matches on opcode alone
+template <typename F0, typename F1, typename F2>
+constexpr auto make_callbacks(F0 f0, F1 f1, F2 f2) {
+    return stdx::make_tuple(
+        msg::callback<"zero", msg_defn>(msg::equal_to<id_field, 0x80>, f0),
+        msg::callback<"one", msg_defn>(msg::equal_to<id_field, 0x80> and
+                                           msg::equal_to<opcode_field, 1>,
+                                       f1),
+        msg::callback<"two", msg_defn>(msg::equal_to<id_field, 0x80> or
+                                           msg::equal_to<opcode_field, 2>,
+                                       f2));
+}
+
+constexpr auto callbacks = make_callbacks(count<0>, count<1>, count<2>);
+constexpr auto prioritized_callbacks =
+    make_callbacks(count<0>, msg::with_priority<1>(count<1>),
+                   msg::with_priority<2>(count<2>));
+
+template <typename S> struct project {
+    constexpr static auto config = callbacks.apply([](auto... cbs) {
+        return cib::config(cib::exports<S>, cib::extend<S>(cbs...));
+    });
+};
+
+template <typename S> struct prioritized_project {
+    constexpr static auto config =
+        prioritized_callbacks.apply([](auto... cbs) {
+            return cib::config(cib::exports<S>, cib::extend<S>(cbs...));
+        });
+};
+
+struct all_service : policy_service<dispatch_all, msg_view_t> {};
+struct first_service : policy_service<dispatch_first, msg_view_t> {};
+struct priority_service : policy_service<dispatch_priority, msg_view_t> {};
+
+using index_spec = msg::index_spec<id_field, opcode_field>;
+struct indexed_all_service
+    : indexed_policy_service<dispatch_all, index_spec, msg_view_t> {};
+struct indexed_first_service
+    : indexed_policy_service<dispatch_first, index_spec, msg_view_t> {};
+struct indexed_priority_service
+    : indexed_policy_service<dispatch_priority, index_spec, msg_view_t> {};
+
+struct tree_all_service
+    : decision_tree_policy_service<dispatch_all, msg_view_t> {};
+struct tree_first_service
+    : decision_tree_policy_service<dispatch_first, msg_view_t> {};
+struct tree_priority_service
+    : decision_tree_policy_service<dispatch_priority, msg_view_t> {};
+
+template <typename S>
+auto handle(std::uint32_t id, std::uint32_t opcode) -> bool {
+    calls = {};
+    return cib::service<S>->handle(
+        test_msg_t{"id"_field = id, "opcode"_field = opcode});
+}
+
+std::string log_buffer{};
+} // namespace
+
+template <>
+inline auto logging::config<> =
+    logging::fmt::config{std::back_inserter(log_buffer)};
+
+TEMPLATE_TEST_CASE("dispatch_all calls every matching callback",
+                   "[policy_service]", all_service, indexed_all_service,
+                   tree_all_service) {
+    cib::nexus<project<TestType>> test_nexus{};
+    test_nexus.init();
+
+    CHECK(handle<TestType>(0x80, 1));
+    CHECK(calls == std::array{1, 1, 1});
+}
+
+TEMPLATE_TEST_CASE("dispatch_first calls the first matching callback",
+                   "[policy_service]", first_service, indexed_first_service,
+                   tree_first_service) {
+    cib::nexus<project<TestType>> test_nexus{};
+    test_nexus.init();
+
+    CHECK(handle<TestType>(0x80, 1));
+    CHECK(calls == std::array{1, 0, 0});
+
+    CHECK(handle<TestType>(0x81, 2));
+    CHECK(calls == std::array{0, 0, 1});
+
+    CHECK(not handle<TestType>(0x81, 1));
+    CHECK(calls == std::array{0, 0, 0});
+}
+
+TEMPLATE_TEST_CASE("dispatch_priority calls the highest priority match",
+                   "[policy_service]", priority_service,
+                   indexed_priority_service, tree_priority_service) {
+    cib::nexus<prioritized_project<TestType>> test_nexus{};
+    test_nexus.init();
+
+    CHECK(handle<TestType>(0x80, 1));
+    CHECK(calls == std::array{0, 0, 1});
+
+    CHECK(handle<TestType>(0x81, 2));
+    CHECK(calls == std::array{0, 0, 1});
+
+    CHECK(not handle<TestType>(0x81, 1));
+    CHECK(calls == std::array{0, 0, 0});
+}
+
+namespace {
+constexpr auto same_priority_callbacks =
+    make_callbacks(count<0>, count<1>, msg::with_priority<-1>(count<2>));
+
+template <typename S> struct same_priority_project {
+    constexpr static auto config =
+        same_priority_callbacks.apply([](auto... cbs) {
+            return cib::config(cib::exports<S>, cib::extend<S>(cbs...));
+        });
+};
+} // namespace
+
+TEMPLATE_TEST_CASE("dispatch_priority breaks ties by registration order",
+                   "[policy_service]", priority_service,
+                   indexed_priority_service, tree_priority_service) {
+    cib::nexus<same_priority_project<TestType>> test_nexus{};
+    test_nexus.init();
+
+    CHECK(handle<TestType>(0x80, 1));
+    CHECK(calls == std::array{1, 0, 0});
+
+    CHECK(handle<TestType>(0x81, 2));
+    CHECK(calls == std::array{0, 0, 1});
+}
+
+TEST_CASE("first match mismatch is logged", "[policy_service]") {
+    cib::nexus<project<first_service>> test_nexus{};
+    test_nexus.init();
+
+    log_buffer.clear();
+    CHECK(not handle<first_service>(0x81, 1));
+    CAPTURE(log_buffer);
+    CHECK(log_buffer.find(
+              "None of the registered callbacks (3) claimed this message") !=
+          std::string::npos);
+}
@@ -0,0 +1,131 @@
+#include <cib/cib.hpp>
+#include <log/fmt/logger.hpp>
+#include <msg/callback.hpp>
+#include <msg/field.hpp>
+#include <msg/message.hpp>
+#include <msg/static_service.hpp>
+
+#include <stdx/panic.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace {
+using namespace msg;
+
+using id_field = field<"id", std::uint32_t>::located<at{0_dw, 31_msb, 24_lsb}>;
+using field1 = field<"f1", std::uint32_t>::located<at{0_dw, 15_msb, 0_lsb}>;
+
+using msg_defn = message<"msg", id_field, field1>;
+using test_msg_t = msg::owning<msg_defn>;
+using msg_view_t = msg::const_view<msg_defn>;
+
+int callback_count;
+int extra_arg_sum;
+
+constexpr auto test_callback = msg::callback<"cb", msg_defn>(
+    msg::equal_to<id_field, 0x80>, [](msg_view_t) { ++callback_count; });
+
+constexpr auto extra_args_callback = msg::callback<"extra", msg_defn>(
+    msg::equal_to<id_field, 0x80>,
+    [](msg_view_t, int value) { extra_arg_sum += value; });
+
+struct test_service : msg::static_service<msg_view_t> {};
+struct test_indexed_service
+    : msg::static_indexed_service<msg::index_spec<id_field>, test_msg_t> {};
+struct extra_args_service : msg::static_service<msg_view_t, int> {};
+struct uninit_service : msg::static_service<msg_view_t> {};
+
+struct test_project {
+    constexpr static auto config =
+        cib::config(cib::exports<test_service, test_indexed_service,
+                                 extra_args_service>,
+                    cib::extend<test_service>(test_callback),
+                    cib::extend<test_indexed_service>(test_callback),
+                    cib::extend<extra_args_service>(extra_args_callback));
+};
+
+std::string log_buffer{};
+
+std::string panic_string{};
+int panics{};
+
+struct test_panic_handler {
+    template <stdx::ct_string Why, typename... Ts>
+    static auto panic(Ts &&...) -> void {
+        panic_string = std::string_view{Why};
+        ++panics;
+    }
+};
+} // namespace
+
+template <>
+inline auto logging::config<> =
+    logging::fmt::config{std::back_inserter(log_buffer)};
+
+template <> inline auto stdx::panic_handler<> = test_panic_handler{};
+
+TEST_CASE("static service is a function pointer", "[static_service]") {
+    static_assert(std::is_same_v<cib::interface_t<test_service>,
+                                 bool (*)(msg_view_t const &)>);
+    static_assert(std::is_pointer_v<std::remove_cvref_t<
+                      decltype(cib::nexus<test_project>::service<
+                               test_service>)>>);
+}
+
+TEST_CASE("handle through a static service", "[static_service]") {
+    cib::nexus<test_project> test_nexus{};
+    test_nexus.init();
+
+    callback_count = 0;
+    CHECK(cib::service<test_service>(test_msg_t{"id"_field = 0x80}));
+    CHECK(callback_count == 1);
+
+    CHECK(not cib::service<test_service>(test_msg_t{"id"_field = 0x81}));
+    CHECK(callback_count == 1);
+}
+
+TEST_CASE("handle through a static indexed service", "[static_service]") {
+    cib::nexus<test_project> test_nexus{};
+    test_nexus.init();
+
+    callback_count = 0;
+    CHECK(cib::service<test_indexed_service>(test_msg_t{"id"_field = 0x80}));
+    CHECK(callback_count == 1);
+
+    CHECK(not cib::service<test_indexed_service>(
+        test_msg_t{"id"_field = 0x81}));
+    CHECK(callback_count == 1);
+}
+
+TEST_CASE("handle directly through the nexus", "[static_service]") {
+    using nexus_t = cib::nexus<test_project>;
+
+    callback_count = 0;
+    CHECK(nexus_t::service<test_service>(test_msg_t{"id"_field = 0x80}));
+    CHECK(nexus_t::service<test_indexed_service>(
+        test_msg_t{"id"_field = 0x80}));
+    CHECK(callback_count == 2);
+}
+
+TEST_CASE("static service with extra callback args", "[static_service]") {
+    cib::nexus<test_project> test_nexus{};
+    test_nexus.init();
+
+    extra_arg_sum = 0;
+    CHECK(cib::service<extra_args_service>(test_msg_t{"id"_field = 0x80}, 42));
+    CHECK(extra_arg_sum == 42);
+}
+
+TEST_CASE("invoke static service when uninitialized", "[static_service]") {
+    panics = 0;
+    cib::service<uninit_service>(test_msg_t{});
+    CHECK(panics == 1);
+    CHECK(panic_string ==
+          "Attempting to handle msg (msg) before service is initialized");
+}
@@ -0,0 +1,148 @@
+#include <msg/field.hpp>
+#include <msg/message.hpp>
+#include <msg/variable_message.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace {
+using namespace msg;
+
+using count_field =
+    field<"count", std::uint8_t>::located<at{0_dw, 7_msb, 0_lsb}>;
+using id_field = field<"id", std::uint8_t>::located<at{0_dw, 31_msb, 24_lsb}>;
+
+using header_defn = message<"header", id_field, count_field>;
+
+using msg_defn =
+    variable_message<header_defn,
+                     repeated_field<"values", std::uint16_t, count_field>,
+                     array_field<"checksum", std::uint32_t, 1>>;
+
+using string_defn = variable_message<header_defn, array_field<"tag", char, 5>,
+                                     array_field<"text", char, 3>>;
+} // namespace
+
+TEST_CASE("fixed sections have a compile-time size", "[variable_message]") {
+    static_assert(string_defn::header_size == 4);
+    static_assert(string_defn::fixed_size == 12);
+    static_assert(msg_defn::fixed_size == 0);
+}
+
+TEST_CASE("section offsets follow the length field", "[variable_message]") {
+    auto data = std::array<std::uint8_t, 16>{3};
+    auto const v = msg_defn::view(data);
+
+    CHECK(v.valid());
+    CHECK(v.get("values"_field).size() == 3);
+    CHECK(v.get("checksum"_field).size() == 1);
+    CHECK(v.offset_of(0) == 4);
+    CHECK(v.offset_of(1) == 10);
+    CHECK(v.size_bytes() == 14);
+}
+
+TEST_CASE("set and get section elements in place", "[variable_message]") {
+    auto data = std::array<std::uint8_t, 16>{2};
+    auto const v = msg_defn::view(data);
+    v.get("values"_field).set(0, 0x1122);
+    v.get("values"_field).set(1, 0x3344);
+    v.get("checksum"_field).set(0, 0xdead'beef);
+
+    CHECK(data[4] == 0x22);
+    CHECK(data[5] == 0x11);
+    CHECK(data[6] == 0x44);
+    CHECK(data[7] == 0x33);
+    CHECK(data[8] == 0xef);
+    CHECK(data[11] == 0xde);
+
+    auto const &cdata = data;
+    auto const cv = msg_defn::view(cdata);
+    CHECK(cv.get("values"_field)[1] == 0x3344);
+    CHECK(cv.get("checksum"_field)[0] == 0xdead'beef);
+}
+
+TEST_CASE("iterate over a repeated field", "[variable_message]") {
+    auto data = std::array<std::uint8_t, 16>{3};
+    auto const values = msg_defn::view(data).get("values"_field);
+    values.assign(std::array<std::uint16_t, 3>{1, 2, 3});
+
+    auto result = std::vector<std::uint16_t>{};
+    std::copy(std::begin(values), std::end(values),
+              std::back_inserter(result));
+    CHECK(result == std::vector<std::uint16_t>{1, 2, 3});
+}
+
+TEST_CASE("sections over dword storage", "[variable_message]") {
+    auto m = owning<header_defn>{"count"_field = 1};
+    auto storage = std::array<std::uint32_t, 3>{};
+    std::copy_n(std::begin(m.data()), 1, std::begin(storage));
+
+    auto const v = msg_defn::view(storage);
+    v.get("values"_field).set(0, 0xabcd);
+    CHECK(v.get("values"_field)[0] == 0xabcd);
+    CHECK(v.size_bytes() == 10);
+}
+
+TEST_CASE("byte sections are seen as a span", "[variable_message]") {
+    auto data = std::array<std::uint8_t, string_defn::fixed_size>{};
+    auto const v = string_defn::view(data);
+    v.get("text"_field).assign(std::string_view{"hello"});
+
+    auto const text = v.get("text"_field).as_span();
+    CHECK(text.data() == reinterpret_cast<char *>(&data[9]));
+    CHECK(std::string_view{text.data(), text.size()} == "hel");
+}
+
+TEST_CASE("a length field larger than the storage gives an invalid view",
+          "[variable_message]") {
+    auto data = std::array<std::uint8_t, 16>{0xff};
+    auto const v = msg_defn::view(data);
+
+    CHECK(not v.valid());
+    CHECK(v.get("values"_field).empty());
+    CHECK(v.get("checksum"_field).empty());
+    CHECK(v.size_bytes() == 0);
+}
+
+TEST_CASE("a section must fit after the length-prefixed one",
+          "[variable_message]") {
+    // 5 values leave 2 bytes of storage, too few for the checksum
+    auto data = std::array<std::uint8_t, 16>{5};
+    CHECK(not msg_defn::view(data).valid());
+
+    data[0] = 4;
+    CHECK(msg_defn::view(data).valid());
+}
+
+TEST_CASE("storage smaller than the header gives an invalid view",
+          "[variable_message]") {
+    auto const data = std::array<std::uint8_t, 2>{};
+    auto const v = string_defn::view(data);
+    CHECK(not v.valid());
+    CHECK(v.get("tag"_field).empty());
+}
+
+TEST_CASE("length fields and sections follow a big-endian header",
+          "[variable_message]") {
+    using big_defn =
+        variable_message<header_defn::with_env<big_endian>,
+                         repeated_field<"values", std::uint16_t, count_field>>;
+    static_assert(big_defn::byte_order == std::endian::big);
+
+    // the count is the least significant byte of the first dword, stored last
+    auto data = std::array<std::uint8_t, 12>{0, 0, 0, 3};
+    auto const v = big_defn::view(data);
+    REQUIRE(v.valid());
+    CHECK(v.get("values"_field).size() == 3);
+
+    v.get("values"_field).set(0, 0x1122);
+    CHECK(data[4] == 0x11);
+    CHECK(data[5] == 0x22);
+}